@@ -0,0 +1,485 @@
+/**
+ * aoc-all: runs every registered day in one process and prints a summary table.
+ *
+ * Usage: aoc-all [--parallel-days] [--days=01,04,...] [--input-dir=<dir>] [runner flags]
+ *        aoc-all --generate=<scale> [--seed=<n>] --output=<dir> [--days=...]
+ *        aoc-all --serve[=<socket>] [--days=...]
+ * The runner flags --threads, --verbose, --alloc, --perf, --bench[=N], --bench-warmup,
+ * --bench-json, --format and --only-part1 behave as they do for a single day: --bench repeats
+ * every part and reports its median, and --alloc/--perf measure each part but are ignored
+ * with --parallel-days, where the process-wide counters cannot be split by day. The
+ * single-day modes --sample, --parallel-parts and --inputs do not apply and are rejected.
+ * Each day reads <dir>/day-xx/input.txt, by default from its source directory; --generate
+ * writes synthetic inputs in that layout instead of solving, and --serve answers requests for
+ * any of the days (see common/Server.hpp).
+ */
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "AllocTracker.hpp"
+#include "Bench.hpp"
+#include "Config.hpp"
+#include "DayRegistry.hpp"
+#include "Generator.hpp"
+#include "InputFile.hpp"
+#include "Parallel.hpp"
+#include "PerfCounters.hpp"
+#include "Results.hpp"
+#include "Server.hpp"
+#include "StringUtils.hpp"
+
+namespace aoc_all
+{
+void registerDays(common::DayRegistry &registry);
+}
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+struct AllOptions
+{
+    bool parallelDays = false;
+    /// Two-digit ids of the days to run; empty runs all of them.
+    std::vector<std::string> days;
+    /// Root holding day-xx/input.txt; empty uses each day's source directory.
+    std::filesystem::path inputDir;
+};
+
+struct PartOutcome
+{
+    bool ran = false;
+    bool failed = false;
+    std::string answer;
+    /// Median of the timed runs (a single run unless --bench).
+    double seconds = 0.0;
+    std::vector<double> samples;
+    std::optional<common::alloc::Stats> allocations;
+    std::optional<common::perf::Reading> counters;
+};
+
+/// Measurements taken around each part besides wall time. Both are process-wide, so they are
+/// only on when the days run one at a time.
+struct PartProbes
+{
+    bool allocations = false;
+    common::perf::PerfCounters *counters = nullptr;
+};
+
+struct DayOutcome
+{
+    /// Why the day did not run, e.g. a missing input; empty if it did.
+    std::string skipped;
+    double loadSeconds = 0.0;
+    std::array<PartOutcome, 2> parts;
+};
+
+/// Consumes the flags specific to aoc-all; the shared ones were already removed by
+/// common::buildRunOptions.
+AllOptions parseAllOptions(int argc, char **argv)
+{
+    AllOptions options;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string_view arg(argv[i]);
+        if (arg == "--parallel-days")
+        {
+            options.parallelDays = true;
+        }
+        else if (arg.starts_with("--days="))
+        {
+            for (auto &day : common::str::split(arg.substr(std::string_view("--days=").size()), ','))
+            {
+                options.days.push_back(day.size() == 1 ? "0" + day : day);
+            }
+        }
+        else if (arg.starts_with("--input-dir="))
+        {
+            options.inputDir = arg.substr(std::string_view("--input-dir=").size());
+        }
+        else
+        {
+            std::cerr << "Ignoring unknown argument: " << arg << std::endl;
+        }
+    }
+    return options;
+}
+
+std::filesystem::path inputPathFor(const common::DayEntry &day, const AllOptions &options)
+{
+    if (options.inputDir.empty())
+    {
+        return day.directory / "input.txt";
+    }
+    return options.inputDir / ("day-" + day.id) / "input.txt";
+}
+
+DayOutcome runOneDay(const common::DayEntry &day,
+                     const std::filesystem::path &inputPath,
+                     const common::RunOptions &options,
+                     const PartProbes &probes)
+{
+    DayOutcome outcome;
+    if (!std::filesystem::exists(inputPath))
+    {
+        outcome.skipped = "no input";
+        return outcome;
+    }
+
+    const auto loadStart = Clock::now();
+    const InputFile input(inputPath.string());
+    const std::chrono::duration<double> loadElapsed = Clock::now() - loadStart;
+    outcome.loadSeconds = loadElapsed.count();
+    const std::array solvers{&day.part1, &day.part2};
+    const std::array enabled{options.runPart1, options.runPart2};
+    // --bench times every part after untimed warmups, as the runner does for a single day.
+    const unsigned warmup = options.benchRuns > 0 ? options.benchWarmup : 0;
+    const unsigned runs = warmup + std::max(1u, options.benchRuns);
+    for (std::size_t i = 0; i < solvers.size(); ++i)
+    {
+        if (!enabled[i])
+        {
+            continue;
+        }
+        auto &part = outcome.parts[i];
+        for (unsigned run = 0; run < runs && !part.failed; ++run)
+        {
+            // Repeated runs solve a copy, whose lazy caches start empty, so no run reuses views
+            // built by an earlier one.
+            std::optional<InputFile> copy;
+            if (runs > 1)
+            {
+                copy.emplace(input);
+            }
+            std::string answer;
+            if (probes.allocations)
+            {
+                common::alloc::reset();
+            }
+            if (probes.counters)
+            {
+                probes.counters->start();
+            }
+            const auto start = Clock::now();
+            try
+            {
+                answer = (*solvers[i])(copy ? *copy : input);
+            }
+            catch (const std::exception &error)
+            {
+                answer = std::string("error: ") + error.what();
+                part.failed = true;
+            }
+            const std::chrono::duration<double> elapsed = Clock::now() - start;
+            if (probes.counters)
+            {
+                part.counters = probes.counters->stop();
+            }
+            if (probes.allocations)
+            {
+                part.allocations = common::alloc::snapshot();
+            }
+
+            if (run >= warmup || part.failed)
+            {
+                part.samples.push_back(elapsed.count());
+            }
+            if (run == 0 || part.failed)
+            {
+                part.answer = answer;
+            }
+            else if (answer != part.answer)
+            {
+                std::cerr << "Day " << day.id << " part " << i + 1 << " returned " << answer << " on run "
+                          << run + 1 << " but " << part.answer << " on run 1." << std::endl;
+                part.failed = true;
+            }
+        }
+        part.seconds = common::bench::summarize(part.samples).median;
+        part.ran = true;
+    }
+    return outcome;
+}
+
+std::string formatMillis(double seconds)
+{
+    std::ostringstream out;
+    out << std::fixed << std::setprecision(3) << seconds * 1000.0;
+    return out.str();
+}
+
+void printSummary(const std::vector<const common::DayEntry *> &days,
+                  const std::vector<DayOutcome> &outcomes,
+                  bool showAllocations)
+{
+    std::array<std::size_t, 2> answerWidth{std::string_view("Part 1").size(), std::string_view("Part 2").size()};
+    for (const auto &outcome : outcomes)
+    {
+        for (std::size_t i = 0; i < 2; ++i)
+        {
+            answerWidth[i] = std::max(answerWidth[i], outcome.parts[i].answer.size());
+        }
+    }
+
+    constexpr int kTimeWidth = 12;
+    std::cout << std::left << std::setw(5) << "Day";
+    for (std::size_t i = 0; i < 2; ++i)
+    {
+        std::cout << (i == 0 ? "" : "  ") << std::left << std::setw(static_cast<int>(answerWidth[i]))
+                  << (i == 0 ? "Part 1" : "Part 2") << std::right << std::setw(kTimeWidth) << "Time (ms)";
+    }
+    if (showAllocations)
+    {
+        std::cout << "  " << std::right << std::setw(12) << "Allocs";
+    }
+    std::cout << '\n';
+
+    for (std::size_t d = 0; d < days.size(); ++d)
+    {
+        const auto &outcome = outcomes[d];
+        std::cout << std::left << std::setw(5) << days[d]->id;
+        if (!outcome.skipped.empty())
+        {
+            std::cout << '(' << outcome.skipped << ")\n";
+            continue;
+        }
+        uint64_t allocations = 0;
+        for (std::size_t i = 0; i < 2; ++i)
+        {
+            const auto &part = outcome.parts[i];
+            std::cout << (i == 0 ? "" : "  ") << std::left << std::setw(static_cast<int>(answerWidth[i]))
+                      << (part.ran ? part.answer : "-") << std::right << std::setw(kTimeWidth)
+                      << (part.ran ? formatMillis(part.seconds) : "-");
+            allocations += part.allocations ? part.allocations->allocations : 0;
+        }
+        if (showAllocations)
+        {
+            std::cout << "  " << std::right << std::setw(12) << allocations;
+        }
+        std::cout << '\n';
+    }
+    // Counter readings do not fit a column, so each part gets a line under the table.
+    for (std::size_t d = 0; d < days.size(); ++d)
+    {
+        for (std::size_t i = 0; i < 2; ++i)
+        {
+            if (const auto &counters = outcomes[d].parts[i].counters)
+            {
+                std::cout << "perf " << days[d]->id << " part " << i + 1 << ": "
+                          << common::perf::formatReading(*counters) << '\n';
+            }
+        }
+    }
+    std::cout << std::left << std::flush;
+}
+/// load, part1 and part2 records for every day that ran, then the season's wall time as
+/// day "all", phase "total".
+std::vector<common::results::Record> buildRecords(const std::vector<const common::DayEntry *> &days,
+                                                  const std::vector<DayOutcome> &outcomes,
+                                                  double wallSeconds)
+{
+    std::vector<common::results::Record> records;
+    for (std::size_t d = 0; d < days.size(); ++d)
+    {
+        const auto &outcome = outcomes[d];
+        if (!outcome.skipped.empty())
+        {
+            continue;
+        }
+        records.push_back({.day = days[d]->id, .phase = "load", .samples = {outcome.loadSeconds}});
+        for (std::size_t i = 0; i < 2; ++i)
+        {
+            const auto &part = outcome.parts[i];
+            if (part.ran)
+            {
+                records.push_back({.day = days[d]->id,
+                                   .phase = i == 0 ? "part1" : "part2",
+                                   .answer = part.answer,
+                                   .samples = part.samples,
+                                   .allocations = part.allocations,
+                                   .counters = part.counters});
+            }
+        }
+    }
+    records.push_back({.day = "all", .phase = "total", .samples = {wallSeconds}});
+    return records;
+}
+/// Writes a synthetic input for every selected day as <--output>/day-xx/input.txt, the layout
+/// --input-dir reads.
+int generateInputs(const std::vector<const common::DayEntry *> &days, const common::RunOptions &options)
+{
+    if (options.generateOutput.empty() || options.generateOutput == "-")
+    {
+        std::cerr << "aoc-all --generate needs --output=<dir> to write day-xx/input.txt into." << std::endl;
+        return 1;
+    }
+    const common::gen::Params params{options.generateScale, options.generateSeed};
+    for (const auto *day : days)
+    {
+        if (!day->generate)
+        {
+            std::cerr << "Day " << day->id << " has no input generator." << std::endl;
+            continue;
+        }
+        const auto path = options.generateOutput / ("day-" + day->id) / "input.txt";
+        try
+        {
+            common::gen::writeTo(day->generate, params, path);
+        }
+        catch (const std::exception &error)
+        {
+            std::cerr << error.what() << std::endl;
+            return 1;
+        }
+        std::cout << "Day " << day->id << ": " << path.string() << " ("
+                  << std::filesystem::file_size(path) << " bytes)" << std::endl;
+    }
+    return 0;
+}
+} // namespace
+
+int main(int argc, char **argv)
+{
+    common::RunOptions options = common::buildRunOptions("all", __FILE__, argc, argv);
+    const AllOptions allOptions = parseAllOptions(argc, argv);
+    common::setVerbose(options.verbose);
+    common::parallel::setThreadCount(options.threads);
+
+    common::DayRegistry registry;
+    aoc_all::registerDays(registry);
+
+    std::vector<const common::DayEntry *> days;
+    for (const auto &day : registry.days())
+    {
+        if (allOptions.days.empty() || std::ranges::find(allOptions.days, day.id) != allOptions.days.end())
+        {
+            days.push_back(&day);
+        }
+    }
+
+    if (options.generateScale > 0)
+    {
+        return generateInputs(days, options);
+    }
+    if (options.serve)
+    {
+        std::vector<common::DayEntry> served;
+        for (const auto *day : days)
+        {
+            served.push_back(*day);
+        }
+        return common::server::serve(served, options.serveSocket);
+    }
+
+    if (options.samplesOnly || options.parallelParts || !options.batchInputs.empty() ||
+        !options.batchInputsFrom.empty())
+    {
+        std::cerr << "aoc-all does not support --sample, --parallel-parts or --inputs; run a single day for those."
+                  << std::endl;
+        return 1;
+    }
+
+    // Allocation and perf counters are process-wide, so they are only per-day when days run
+    // one at a time.
+    const bool trackAllocations = options.allocations && !allOptions.parallelDays;
+    if (options.allocations && allOptions.parallelDays)
+    {
+        std::cerr << "--alloc is ignored with --parallel-days: counts cannot be split by day." << std::endl;
+    }
+    common::alloc::setTracking(trackAllocations);
+    std::optional<common::perf::PerfCounters> counters;
+    if (options.perf && allOptions.parallelDays)
+    {
+        std::cerr << "--perf is ignored with --parallel-days: counters cannot be split by day." << std::endl;
+    }
+    else if (options.perf)
+    {
+        counters.emplace();
+        if (!counters->available())
+        {
+            std::cerr << "perf: counters unavailable (" << counters->unavailableReason()
+                      << "); check /proc/sys/kernel/perf_event_paranoid or container seccomp settings."
+                      << std::endl;
+            counters.reset();
+        }
+    }
+    const PartProbes probes{trackAllocations, counters ? &*counters : nullptr};
+
+    std::vector<DayOutcome> outcomes(days.size());
+    const auto wallStart = Clock::now();
+    const auto runDay = [&](std::size_t d) {
+        outcomes[d] = runOneDay(*days[d], inputPathFor(*days[d], allOptions), options, probes);
+    };
+    if (allOptions.parallelDays)
+    {
+        // Days share the process-wide pool with the mapReduce calls inside their solvers.
+        common::parallel::parallelFor(days.size(), runDay);
+    }
+    else
+    {
+        for (std::size_t d = 0; d < days.size(); ++d)
+        {
+            runDay(d);
+        }
+    }
+    const std::chrono::duration<double> wall = Clock::now() - wallStart;
+    common::alloc::setTracking(false);
+
+    double solveSeconds = 0.0;
+    std::size_t ranDays = 0;
+    bool failed = false;
+    for (const auto &outcome : outcomes)
+    {
+        ranDays += outcome.skipped.empty() ? 1 : 0;
+        for (const auto &part : outcome.parts)
+        {
+            solveSeconds += part.seconds;
+            failed = failed || part.failed;
+        }
+    }
+    if (!options.benchJsonPath.empty() && options.benchJsonPath != "-")
+    {
+        std::ofstream json(options.benchJsonPath);
+        if (!json.is_open())
+        {
+            std::cerr << "Could not write benchmark report to " << options.benchJsonPath.string() << std::endl;
+            return 1;
+        }
+        common::results::writeJson(json, buildRecords(days, outcomes, wall.count()));
+    }
+    if (options.format == common::results::Format::Json || options.benchJsonPath == "-")
+    {
+        common::results::writeJson(std::cout, buildRecords(days, outcomes, wall.count()));
+        return failed ? 1 : 0;
+    }
+    if (options.format == common::results::Format::Csv)
+    {
+        common::results::writeCsv(std::cout, buildRecords(days, outcomes, wall.count()));
+        return failed ? 1 : 0;
+    }
+
+    printSummary(days, outcomes, trackAllocations);
+    std::cout << "Total: " << formatMillis(wall.count()) << " ms wall for " << ranDays << " days ("
+              << (allOptions.parallelDays ? "parallel" : "sequential") << "); parts sum to "
+              << formatMillis(solveSeconds) << " ms";
+    if (options.benchRuns > 0)
+    {
+        std::cout << " (part times are medians of " << options.benchRuns << " runs)";
+    }
+    std::cout << std::endl;
+    return failed ? 1 : 0;
+}
@@ -0,0 +1,467 @@
+/**
+ * Microbenchmarks for the common library.
+ *
+ * Usage: common-bench [--runs=N] [--format=text|json|csv] [filter]
+ * Only benchmarks whose name contains the filter are run. JSON and CSV use the runner's
+ * result schema with day "common" and the benchmark name as the phase, so two runs can be
+ * compared with util/compare-results.py.
+ */
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <numbers>
+#include <random>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "Bench.hpp"
+#include "BitsetUtils.hpp"
+#include "DynamicBitset.hpp"
+#include "ExactMath.hpp"
+#include "Geometry.hpp"
+#include "Grid.hpp"
+#include "MathUtils.hpp"
+#include "Results.hpp"
+#include "Search.hpp"
+#include "StringUtils.hpp"
+
+namespace
+{
+using Clock = std::chrono::steady_clock;
+
+struct Benchmark
+{
+    std::string name;
+    std::function<void()> body;
+};
+
+/// Keeps the optimiser from discarding a benchmark result.
+template <typename T>
+void doNotOptimize(const T &value)
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+std::vector<double> sampleSeconds(const Benchmark &bench, unsigned runs)
+{
+    std::vector<double> samples;
+    samples.reserve(runs);
+    bench.body(); // warmup
+    for (unsigned i = 0; i < runs; ++i)
+    {
+        const auto start = Clock::now();
+        bench.body();
+        const std::chrono::duration<double> elapsed = Clock::now() - start;
+        samples.push_back(elapsed.count());
+    }
+    return samples;
+}
+
+/// Random XOR subset instance with a reachable target, so the exhaustive search
+/// cannot stop early on an inconsistent system.
+struct XorInstance
+{
+    std::vector<std::bitset<32>> candidates;
+    std::bitset<32> target;
+};
+
+XorInstance makeXorInstance(std::size_t n, uint32_t seed)
+{
+    std::mt19937 rng(seed);
+    XorInstance instance;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        instance.candidates.emplace_back(rng() & 0xFFFFu);
+        if (rng() & 1U)
+        {
+            instance.target ^= instance.candidates.back();
+        }
+    }
+    return instance;
+}
+
+std::vector<Benchmark> xorSubsetBenchmarks()
+{
+    std::vector<Benchmark> benchmarks;
+    for (const std::size_t n : {16, 20, 24})
+    {
+        auto instance = std::make_shared<XorInstance>(makeXorInstance(n, static_cast<uint32_t>(n)));
+        benchmarks.push_back({"findMinimalXorSubsetExhaustive/n=" + std::to_string(n), [instance] {
+                                  doNotOptimize(common::bitset_utils::findMinimalXorSubsetExhaustive(
+                                      instance->candidates, instance->target));
+                              }});
+        benchmarks.push_back({"findMinimalXorSubset/n=" + std::to_string(n), [instance] {
+                                  doNotOptimize(common::bitset_utils::findMinimalXorSubset(
+                                      instance->candidates, instance->target));
+                              }});
+    }
+    return benchmarks;
+}
+
+/// XOR-accumulate and popcount over a pool of bitsets: the inner loop of the GF(2) search.
+template <typename Bits>
+std::size_t xorPopcountLoop(const std::vector<Bits> &pool, std::size_t rounds)
+{
+    Bits acc = pool.front();
+    std::size_t total = 0;
+    for (std::size_t r = 0; r < rounds; ++r)
+    {
+        acc ^= pool[r % pool.size()];
+        total += acc.count();
+    }
+    return total;
+}
+
+std::vector<Benchmark> bitsetBenchmarks()
+{
+    constexpr std::size_t kRounds = 1 << 20;
+    std::mt19937_64 rng(64);
+    auto narrow = std::make_shared<std::vector<std::bitset<64>>>();
+    auto dynamicNarrow = std::make_shared<std::vector<common::DynamicBitset>>();
+    for (int i = 0; i < 64; ++i)
+    {
+        const uint64_t word = rng();
+        narrow->emplace_back(word);
+        common::DynamicBitset bits(64);
+        for (std::size_t b = 0; b < 64; ++b)
+        {
+            bits.set(b, (word >> b) & 1U);
+        }
+        dynamicNarrow->push_back(std::move(bits));
+    }
+
+    auto wide = std::make_shared<std::vector<std::bitset<4096>>>();
+    auto dynamicWide = std::make_shared<std::vector<common::DynamicBitset>>();
+    for (int i = 0; i < 64; ++i)
+    {
+        std::bitset<4096> bits;
+        common::DynamicBitset dynamicBits(4096);
+        for (std::size_t b = 0; b < 4096; ++b)
+        {
+            const bool value = rng() & 1U;
+            bits.set(b, value);
+            dynamicBits.set(b, value);
+        }
+        wide->push_back(bits);
+        dynamicWide->push_back(std::move(dynamicBits));
+    }
+
+    return {
+        {"bitset<64>/xor+count", [narrow] { doNotOptimize(xorPopcountLoop(*narrow, kRounds)); }},
+        {"DynamicBitset(64)/xor+count", [dynamicNarrow] { doNotOptimize(xorPopcountLoop(*dynamicNarrow, kRounds)); }},
+        {"bitset<4096>/xor+count", [wide] { doNotOptimize(xorPopcountLoop(*wide, kRounds / 64)); }},
+        {"DynamicBitset(4096)/xor+count", [dynamicWide] { doNotOptimize(xorPopcountLoop(*dynamicWide, kRounds / 64)); }},
+    };
+}
+
+/// Day-10 shaped systems: 0/1 button columns and a joltage right-hand side.
+std::vector<common::math::IntMatrix> makeButtonSystems(std::size_t count, std::size_t rows, std::size_t cols)
+{
+    std::mt19937 rng(10);
+    std::vector<common::math::IntMatrix> systems;
+    for (std::size_t s = 0; s < count; ++s)
+    {
+        common::math::IntMatrix matrix(rows, cols + 1);
+        for (std::size_t r = 0; r < rows; ++r)
+        {
+            for (std::size_t c = 0; c < cols; ++c)
+            {
+                matrix(r, c) = (rng() % 3 == 0) ? 1 : 0;
+            }
+            matrix(r, cols) = rng() % 200;
+        }
+        systems.push_back(std::move(matrix));
+    }
+    return systems;
+}
+
+std::vector<Benchmark> eliminationBenchmarks()
+{
+    std::vector<Benchmark> benchmarks;
+    for (const auto &[rows, cols] : {std::pair<std::size_t, std::size_t>{6, 8}, {10, 13}})
+    {
+        auto systems = std::make_shared<std::vector<common::math::IntMatrix>>(makeButtonSystems(10000, rows, cols));
+        benchmarks.push_back({"bareissReduce/" + std::to_string(rows) + "x" + std::to_string(cols), [systems, cols] {
+                                  for (auto matrix : *systems)
+                                  {
+                                      const auto reduced = common::math::bareissReduce(matrix, cols);
+                                      common::math::normalizeRows(matrix, reduced);
+                                      doNotOptimize(matrix(0, cols));
+                                  }
+                              }});
+    }
+    return benchmarks;
+}
+
+
+/// Input sizes shared by the parameterised benchmarks below.
+constexpr std::array<std::size_t, 3> kSizes{1 << 10, 1 << 13, 1 << 16};
+
+/// Comma-separated numbers with a space after every comma, like the puzzle inputs.
+std::string makeNumberList(std::size_t count, uint32_t seed)
+{
+    std::mt19937 rng(seed);
+    std::string text;
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        text += (i == 0 ? "" : ", ") + std::to_string(rng() % 100000);
+    }
+    return text;
+}
+
+std::vector<Benchmark> stringBenchmarks()
+{
+    std::vector<Benchmark> benchmarks;
+    for (const std::size_t n : kSizes)
+    {
+        const auto suffix = "/n=" + std::to_string(n);
+        auto list = std::make_shared<std::string>(makeNumberList(n, static_cast<uint32_t>(n)));
+        auto padded = std::make_shared<std::vector<std::string>>();
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            padded->push_back("  \t" + std::to_string(i) + " value " + std::to_string(i * 7) + "  \r");
+        }
+        benchmarks.push_back({"str::split" + suffix, [list] { doNotOptimize(common::str::split(*list, ',')); }});
+        benchmarks.push_back({"str::tokens" + suffix, [list] {
+                                  std::size_t total = 0;
+                                  for (const auto token : common::str::tokens(*list, ','))
+                                  {
+                                      total += token.size();
+                                  }
+                                  doNotOptimize(total);
+                              }});
+        benchmarks.push_back({"str::tokens(any-of)" + suffix, [list] {
+                                  std::size_t total = 0;
+                                  for (const auto token : common::str::tokens(*list, ", "))
+                                  {
+                                      total += token.size();
+                                  }
+                                  doNotOptimize(total);
+                              }});
+        benchmarks.push_back({"str::to_vector_of_numbers" + suffix,
+                              [list] { doNotOptimize(common::str::to_vector_of_numbers(*list, ',')); }});
+        benchmarks.push_back({"str::trim_copy" + suffix, [padded] {
+                                  std::size_t total = 0;
+                                  for (const auto &line : *padded)
+                                  {
+                                      total += common::str::trim_copy(line).size();
+                                  }
+                                  doNotOptimize(total);
+                              }});
+    }
+    return benchmarks;
+}
+
+std::vector<Benchmark> gridBenchmarks()
+{
+    using common::grid::Coordinate;
+    std::vector<Benchmark> benchmarks;
+    for (const std::size_t n : kSizes)
+    {
+        // A square grid with about n cells.
+        const auto side = static_cast<std::size_t>(std::sqrt(static_cast<double>(n)));
+        const auto suffix = "/cells=" + std::to_string(side * side);
+        benchmarks.push_back({"grid::orthogonalNeighbors" + suffix, [side] {
+                                  std::size_t total = 0;
+                                  for (const auto coord : common::grid::CoordinateRange(side, side))
+                                  {
+                                      total += common::grid::orthogonalNeighbors(coord, side, side).size();
+                                  }
+                                  doNotOptimize(total);
+                              }});
+        benchmarks.push_back({"grid::allNeighbors" + suffix, [side] {
+                                  std::size_t total = 0;
+                                  for (const auto coord : common::grid::CoordinateRange(side, side))
+                                  {
+                                      total += common::grid::allNeighbors(coord, side, side).size();
+                                  }
+                                  doNotOptimize(total);
+                              }});
+        benchmarks.push_back({"grid::CoordinateRange" + suffix, [side] {
+                                  int64_t total = 0;
+                                  for (const auto coord : common::grid::CoordinateRange(side, side))
+                                  {
+                                      total += coord.x ^ coord.y;
+                                  }
+                                  doNotOptimize(total);
+                              }});
+    }
+    return benchmarks;
+}
+
+std::vector<Benchmark> searchBenchmarks()
+{
+    using common::grid::Coordinate;
+    std::vector<Benchmark> benchmarks;
+    for (const std::size_t n : kSizes)
+    {
+        const auto side = static_cast<std::size_t>(std::sqrt(static_cast<double>(n)));
+        const auto suffix = "/cells=" + std::to_string(side * side);
+        // Open grid with a deterministic per-cell entry cost for the weighted search.
+        auto costs = std::make_shared<common::grid::Grid<int>>(side, side);
+        std::mt19937 rng(static_cast<uint32_t>(n));
+        for (auto &cost : *costs)
+        {
+            cost = static_cast<int>(rng() % 9) + 1;
+        }
+        benchmarks.push_back({"search::bfs" + suffix, [side] {
+                                  const auto neighbors = [side](const Coordinate &coord) {
+                                      return common::grid::orthogonalNeighbors(coord, side, side);
+                                  };
+                                  doNotOptimize(common::search::bfs(neighbors, Coordinate{0, 0}).size());
+                              }});
+        benchmarks.push_back({"search::dijkstra" + suffix, [side, costs] {
+                                  const auto neighbors = [side, costs](const Coordinate &coord) {
+                                      std::vector<std::pair<Coordinate, int>> weighted;
+                                      for (const auto next : common::grid::orthogonalNeighbors(coord, side, side))
+                                      {
+                                          weighted.emplace_back(next, (*costs)[next]);
+                                      }
+                                      return weighted;
+                                  };
+                                  doNotOptimize(
+                                      common::search::dijkstra<Coordinate, int>(neighbors, Coordinate{0, 0}).size());
+                              }});
+    }
+    return benchmarks;
+}
+
+std::vector<Benchmark> geometryBenchmarks()
+{
+    using common::geometry::Point;
+    std::vector<Benchmark> benchmarks;
+    // Larger than kSizes' top end would take seconds per run; these still need many batches.
+    for (const std::size_t n : {std::size_t{1} << 10, std::size_t{1} << 12, std::size_t{1} << 14})
+    {
+        const auto suffix = "/points=" + std::to_string(n);
+        // Jittered points on a circle, like the polygon corners of day 9.
+        constexpr double kRadius = 100'000.0;
+        auto points = std::make_shared<std::vector<Point>>();
+        std::mt19937 rng(static_cast<uint32_t>(n));
+        std::uniform_real_distribution<double> angle(0.0, 2.0 * std::numbers::pi);
+        std::uniform_real_distribution<double> jitter(0.9, 1.0);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            const double theta = angle(rng);
+            const double radius = kRadius * jitter(rng);
+            points->push_back({static_cast<int64_t>(kRadius + radius * std::cos(theta)),
+                               static_cast<int64_t>(kRadius + radius * std::sin(theta))});
+        }
+        // Only rectangles under 40% of the bounding box pass, so millions of larger pairs
+        // are ranked and rejected first, as in the day-9 search on scaled inputs.
+        const auto limit = static_cast<uint64_t>(1.6 * kRadius * kRadius);
+        benchmarks.push_back({"geometry::largestRectangleWhere" + suffix, [points, limit] {
+                                  const auto accept = [limit](const Point &a, const Point &b) {
+                                      return common::geometry::rectangleArea(a, b) <= limit;
+                                  };
+                                  doNotOptimize(common::geometry::largestRectangleWhere(*points, accept).value_or(0));
+                              }});
+    }
+    return benchmarks;
+}
+
+std::vector<Benchmark> mathBenchmarks()
+{
+    std::vector<Benchmark> benchmarks;
+    for (const std::size_t n : kSizes)
+    {
+        const auto suffix = "/n=" + std::to_string(n);
+        auto values = std::make_shared<std::vector<int64_t>>(n);
+        std::mt19937_64 rng(n);
+        for (auto &value : *values)
+        {
+            value = static_cast<int64_t>(rng() >> 1);
+        }
+        benchmarks.push_back({"math::pow_mod" + suffix, [values] {
+                                  int64_t total = 0;
+                                  for (const auto value : *values)
+                                  {
+                                      total ^= common::math::pow_mod<int64_t>(value % 1000003, value, 1000000007);
+                                  }
+                                  doNotOptimize(total);
+                              }});
+        benchmarks.push_back({"math::min" + suffix, [values] { doNotOptimize(common::math::min(*values).index); }});
+        benchmarks.push_back({"math::max" + suffix, [values] { doNotOptimize(common::math::max(*values).index); }});
+    }
+    return benchmarks;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    std::string_view filter;
+    unsigned runs = 5;
+    auto format = common::results::Format::Text;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string_view arg = argv[i];
+        if (arg.starts_with("--runs="))
+        {
+            const auto value = arg.substr(std::string_view("--runs=").size());
+            const auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), runs);
+            if (ec != std::errc() || ptr != value.data() + value.size() || runs == 0)
+            {
+                std::cerr << "Invalid run count: " << value << std::endl;
+                return 1;
+            }
+        }
+        else if (arg.starts_with("--format="))
+        {
+            const auto parsed = common::results::parseFormat(arg.substr(std::string_view("--format=").size()));
+            if (!parsed)
+            {
+                std::cerr << "Unknown format: " << arg << std::endl;
+                return 1;
+            }
+            format = *parsed;
+        }
+        else
+        {
+            filter = arg;
+        }
+    }
+
+    std::vector<Benchmark> benchmarks;
+    for (auto &&group : {xorSubsetBenchmarks(), bitsetBenchmarks(), eliminationBenchmarks(), stringBenchmarks(),
+                         gridBenchmarks(), searchBenchmarks(), mathBenchmarks(), geometryBenchmarks()})
+    {
+        benchmarks.insert(benchmarks.end(), group.begin(), group.end());
+    }
+
+    std::vector<common::results::Record> records;
+    for (const auto &bench : benchmarks)
+    {
+        if (!filter.empty() && bench.name.find(filter) == std::string::npos)
+        {
+            continue;
+        }
+        auto samples = sampleSeconds(bench, runs);
+        if (format == common::results::Format::Text)
+        {
+            const auto summary = common::bench::summarize(samples);
+            std::cout << bench.name << ": " << summary.median * 1e3 << " ms median, " << summary.min * 1e3
+                      << " ms min (" << runs << " runs)" << std::endl;
+        }
+        records.push_back({.day = "common", .phase = bench.name, .samples = std::move(samples)});
+    }
+
+    if (format == common::results::Format::Json)
+    {
+        common::results::writeJson(std::cout, records);
+    }
+    else if (format == common::results::Format::Csv)
+    {
+        common::results::writeCsv(std::cout, records);
+    }
+    return 0;
+}
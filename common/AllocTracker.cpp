@@ -0,0 +1,222 @@
+#include "AllocTracker.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <iomanip>
+#include <iterator>
+#include <limits>
+#include <new>
+#include <sstream>
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+#if defined(__GLIBC__)
+#include <malloc.h>
+#endif
+
+namespace common::alloc
+{
+namespace
+{
+std::atomic<bool> g_tracking{false};
+std::atomic<uint64_t> g_allocations{0};
+std::atomic<uint64_t> g_frees{0};
+std::atomic<uint64_t> g_bytes{0};
+std::atomic<int64_t> g_liveBytes{0};
+std::atomic<int64_t> g_peakLiveBytes{0};
+
+/// Size the allocator really handed out, so a block counts the same on allocation and free.
+int64_t usableSize(void *ptr, std::size_t requested)
+{
+#if defined(__GLIBC__)
+    (void)requested;
+    return static_cast<int64_t>(malloc_usable_size(ptr));
+#else
+    (void)ptr;
+    return static_cast<int64_t>(requested);
+#endif
+}
+
+void recordAllocation(void *ptr, std::size_t size)
+{
+    if (!ptr || !g_tracking.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    g_bytes.fetch_add(size, std::memory_order_relaxed);
+    const int64_t added = usableSize(ptr, size);
+    const int64_t live = g_liveBytes.fetch_add(added, std::memory_order_relaxed) + added;
+    int64_t peak = g_peakLiveBytes.load(std::memory_order_relaxed);
+    while (live > peak && !g_peakLiveBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+    {
+    }
+}
+
+void recordFree(void *ptr)
+{
+    if (!ptr || !g_tracking.load(std::memory_order_relaxed))
+    {
+        return;
+    }
+    g_frees.fetch_add(1, std::memory_order_relaxed);
+#if defined(__GLIBC__)
+    g_liveBytes.fetch_sub(usableSize(ptr, 0), std::memory_order_relaxed);
+#endif
+}
+
+/// What operator new must do after a failed attempt: call the installed new-handler so it
+/// can free memory (or throw), and throw std::bad_alloc only when there is none.
+void handleAllocationFailure()
+{
+    const std::new_handler handler = std::get_new_handler();
+    if (!handler)
+    {
+        throw std::bad_alloc();
+    }
+    handler();
+}
+
+void *allocate(std::size_t size)
+{
+    const std::size_t bytes = size == 0 ? 1 : size;
+    void *ptr = std::malloc(bytes);
+    while (!ptr)
+    {
+        handleAllocationFailure();
+        ptr = std::malloc(bytes);
+    }
+    recordAllocation(ptr, size);
+    return ptr;
+}
+
+void *allocateAligned(std::size_t size, std::align_val_t alignment)
+{
+    const auto align = static_cast<std::size_t>(alignment);
+    // aligned_alloc wants a size that is a multiple of the alignment. A size that cannot be
+    // rounded up can never be satisfied, so no handler could help.
+    if (size > std::numeric_limits<std::size_t>::max() - align)
+    {
+        throw std::bad_alloc();
+    }
+    const std::size_t rounded = (std::max<std::size_t>(size, 1) + align - 1) / align * align;
+    void *ptr = std::aligned_alloc(align, rounded);
+    while (!ptr)
+    {
+        handleAllocationFailure();
+        ptr = std::aligned_alloc(align, rounded);
+    }
+    recordAllocation(ptr, size);
+    return ptr;
+}
+
+void release(void *ptr) noexcept
+{
+    recordFree(ptr);
+    std::free(ptr);
+}
+
+} // namespace
+
+void setTracking(bool enabled)
+{
+    g_tracking = enabled;
+}
+
+bool tracking()
+{
+    return g_tracking;
+}
+
+void reset()
+{
+    g_allocations = 0;
+    g_frees = 0;
+    g_bytes = 0;
+    g_liveBytes = 0;
+    g_peakLiveBytes = 0;
+}
+
+Stats snapshot()
+{
+    return Stats{g_allocations.load(), g_frees.load(), g_bytes.load(), g_peakLiveBytes.load()};
+}
+
+uint64_t peakRssBytes()
+{
+#if defined(__linux__)
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) == 0)
+    {
+        return static_cast<uint64_t>(usage.ru_maxrss) * 1024; // kilobytes on Linux
+    }
+#elif defined(__APPLE__)
+    rusage usage{};
+    if (getrusage(RUSAGE_SELF, &usage) == 0)
+    {
+        return static_cast<uint64_t>(usage.ru_maxrss); // bytes on macOS
+    }
+#endif
+    return 0;
+}
+
+std::string formatBytes(double bytes)
+{
+    static constexpr const char *kUnits[] = {"B", "KiB", "MiB", "GiB"};
+    std::size_t unit = 0;
+    const bool negative = bytes < 0;
+    bytes = negative ? -bytes : bytes;
+    while (bytes >= 1024.0 && unit + 1 < std::size(kUnits))
+    {
+        bytes /= 1024.0;
+        ++unit;
+    }
+    std::ostringstream out;
+    out << (negative ? "-" : "") << std::fixed << std::setprecision(unit == 0 ? 0 : 2) << bytes << ' ' << kUnits[unit];
+    return out.str();
+}
+std::string formatStats(const Stats &stats)
+{
+    std::ostringstream out;
+    out << stats.allocations << " allocations, " << stats.frees << " frees, "
+        << formatBytes(static_cast<double>(stats.bytes)) << " requested, peak "
+        << formatBytes(static_cast<double>(stats.peakLiveBytes)) << " live";
+    return out.str();
+}
+
+} // namespace common::alloc
+
+// Replacements for the global allocation functions. The array and nothrow forms forward to
+// these in libstdc++ and libc++. The sized deletes are replaced as well, as the standard
+// requires alongside the unsized ones, so no release depends on the library's defaults.
+void *operator new(std::size_t size)
+{
+    return common::alloc::allocate(size);
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment)
+{
+    return common::alloc::allocateAligned(size, alignment);
+}
+
+void operator delete(void *ptr) noexcept
+{
+    common::alloc::release(ptr);
+}
+
+void operator delete(void *ptr, std::align_val_t) noexcept
+{
+    common::alloc::release(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept
+{
+    ::operator delete(ptr);
+}
+
+void operator delete(void *ptr, std::size_t, std::align_val_t alignment) noexcept
+{
+    ::operator delete(ptr, alignment);
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace common::alloc
+{
+/// @brief Heap activity since the last reset(), across all threads.
+struct Stats
+{
+    uint64_t allocations = 0;
+    uint64_t frees = 0;
+    /// Bytes requested from operator new.
+    uint64_t bytes = 0;
+    /// High-water mark of live heap bytes (usable size) above the level at reset(). Frees of
+    /// blocks allocated before the reset can take the live level below zero. Without glibc's
+    /// malloc_usable_size, frees are not subtracted and this is total bytes requested.
+    int64_t peakLiveBytes = 0;
+};
+
+/**
+ * @brief Turns counting in the replaced global operator new/delete on or off.
+ *
+ * The Common library replaces the global allocation functions, but they only count while
+ * tracking is on; otherwise each call costs one relaxed atomic load on top of malloc/free.
+ * Counters are process-wide atomics, so concurrent parts are counted together.
+ */
+void setTracking(bool enabled);
+bool tracking();
+
+/// @brief Zeroes the counters and makes the current live heap level the baseline.
+void reset();
+
+Stats snapshot();
+
+/// @brief Peak resident set size of the process so far, from getrusage (0 if unavailable).
+uint64_t peakRssBytes();
+
+/// @brief bytes in B/KiB/MiB/GiB, e.g. "1.50 MiB".
+std::string formatBytes(double bytes);
+
+/// @brief One-line summary, e.g. "12.3K allocations, 12.3K frees, 1.50 MiB requested, ...".
+std::string formatStats(const Stats &stats);
+
+} // namespace common::alloc
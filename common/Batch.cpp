@@ -0,0 +1,337 @@
+#include "Batch.hpp"
+
+#include <glob.h>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include "Bench.hpp"
+#include "Parallel.hpp"
+#include "Results.hpp"
+#include "StringUtils.hpp"
+
+namespace common::batch
+{
+namespace
+{
+/// Loaded files waiting for a worker, per worker thread.
+constexpr std::size_t kQueuedPerWorker = 4;
+constexpr double kMegabyte = 1e6;
+
+/// Blocking FIFO with a fixed capacity, so the I/O thread cannot run arbitrarily far ahead.
+template <typename T>
+class BoundedQueue
+{
+public:
+    explicit BoundedQueue(std::size_t capacity) : m_capacity(capacity) {}
+
+    void push(T item)
+    {
+        std::unique_lock lock(m_mutex);
+        m_notFull.wait(lock, [&] { return m_items.size() < m_capacity; });
+        m_items.push_back(std::move(item));
+        m_notEmpty.notify_one();
+    }
+
+    /// Next item, or std::nullopt once the queue is closed and drained.
+    std::optional<T> pop()
+    {
+        std::unique_lock lock(m_mutex);
+        m_notEmpty.wait(lock, [&] { return !m_items.empty() || m_closed; });
+        if (m_items.empty())
+        {
+            return std::nullopt;
+        }
+        T item = std::move(m_items.front());
+        m_items.pop_front();
+        m_notFull.notify_one();
+        return item;
+    }
+
+    void close()
+    {
+        std::lock_guard lock(m_mutex);
+        m_closed = true;
+        m_notEmpty.notify_all();
+    }
+
+private:
+    std::size_t m_capacity;
+    std::deque<T> m_items;
+    bool m_closed = false;
+    std::mutex m_mutex;
+    std::condition_variable m_notFull;
+    std::condition_variable m_notEmpty;
+};
+
+struct LoadedInput
+{
+    std::size_t index = 0;
+    std::string text{};
+    double loadSeconds = 0.0;
+    /// Why the file could not be read; empty on success.
+    std::string error{};
+};
+
+struct Outcome
+{
+    bool finished = false;
+    std::string error;
+    std::uintmax_t bytes = 0;
+    double loadSeconds = 0.0;
+    double parseSeconds = 0.0;
+    std::array<std::optional<std::string>, 2> answers;
+    std::array<double, 2> partSeconds{};
+};
+
+LoadedInput loadInput(std::size_t index, const std::filesystem::path &path)
+{
+    LoadedInput loaded{.index = index};
+    loaded.loadSeconds = bench::timeSeconds([&] {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open())
+        {
+            loaded.error = "Could not open file: " + path.string();
+            return;
+        }
+        loaded.text.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    });
+    return loaded;
+}
+
+void printOutcome(const std::filesystem::path &path, const Outcome &outcome)
+{
+    std::cout << path.string() << ':';
+    if (!outcome.error.empty())
+    {
+        std::cout << " error: " << outcome.error << std::endl;
+        return;
+    }
+    for (const auto &answer : outcome.answers)
+    {
+        if (answer)
+        {
+            std::cout << ' ' << *answer;
+        }
+    }
+    std::cout << " (" << outcome.partSeconds[0] + outcome.partSeconds[1] << "s)" << std::endl;
+}
+
+std::vector<results::Record> batchRecords(std::string_view dayId,
+                                          const std::vector<Outcome> &outcomes,
+                                          const RunOptions &options,
+                                          double wallSeconds)
+{
+    std::vector<results::Record> records;
+    const auto perInput = [&](std::string phase, auto &&seconds) {
+        results::Record record{.day = std::string(dayId), .phase = std::move(phase)};
+        for (const auto &outcome : outcomes)
+        {
+            if (outcome.error.empty())
+            {
+                record.samples.push_back(seconds(outcome));
+            }
+        }
+        records.push_back(std::move(record));
+    };
+    perInput("load", [](const Outcome &outcome) { return outcome.loadSeconds; });
+    perInput("parse", [](const Outcome &outcome) { return outcome.parseSeconds; });
+    if (options.runPart1)
+    {
+        perInput("part1", [](const Outcome &outcome) { return outcome.partSeconds[0]; });
+    }
+    if (options.runPart2)
+    {
+        perInput("part2", [](const Outcome &outcome) { return outcome.partSeconds[1]; });
+    }
+    records.push_back(
+        {.day = std::string(dayId), .phase = "batch", .samples = {wallSeconds}, .inputs = outcomes.size()});
+    return records;
+}
+} // namespace
+
+std::vector<std::filesystem::path> expandInputs(std::string_view dirOrGlob)
+{
+    const std::filesystem::path root(dirOrGlob);
+    std::vector<std::filesystem::path> inputs;
+    std::error_code error;
+    if (std::filesystem::is_directory(root, error))
+    {
+        for (const auto &entry : std::filesystem::directory_iterator(root))
+        {
+            if (entry.is_regular_file())
+            {
+                inputs.push_back(entry.path());
+            }
+        }
+    }
+    else
+    {
+        glob_t matches{};
+        const std::string pattern(dirOrGlob);
+        if (::glob(pattern.c_str(), 0, nullptr, &matches) == 0)
+        {
+            for (std::size_t i = 0; i < matches.gl_pathc; ++i)
+            {
+                inputs.emplace_back(matches.gl_pathv[i]);
+            }
+        }
+        ::globfree(&matches);
+    }
+
+    if (inputs.empty())
+    {
+        throw std::runtime_error("No input files match " + std::string(dirOrGlob));
+    }
+    std::sort(inputs.begin(), inputs.end());
+    return inputs;
+}
+
+std::vector<std::filesystem::path> readInputList(const std::filesystem::path &listFile)
+{
+    std::ifstream file(listFile);
+    if (!file.is_open())
+    {
+        throw std::runtime_error("Could not open file: " + listFile.string());
+    }
+    std::vector<std::filesystem::path> inputs;
+    std::string line;
+    while (std::getline(file, line))
+    {
+        const auto entry = str::trim_view(line);
+        if (!entry.empty() && !entry.starts_with('#'))
+        {
+            inputs.emplace_back(entry);
+        }
+    }
+    if (inputs.empty())
+    {
+        throw std::runtime_error("No input files listed in " + listFile.string());
+    }
+    return inputs;
+}
+
+int runBatch(const RunOptions &options,
+             std::string_view dayId,
+             const std::vector<std::filesystem::path> &inputs,
+             const std::function<std::string(const InputFile &)> &part1,
+             const std::function<std::string(const InputFile &)> &part2)
+{
+    const bool textOutput = options.format == results::Format::Text;
+    const unsigned workers = parallel::threadCount();
+    BoundedQueue<LoadedInput> queue(kQueuedPerWorker * workers);
+    std::vector<Outcome> outcomes(inputs.size());
+
+    // Answers are printed in input order: whoever completes the next unprinted input
+    // prints it and any finished inputs right behind it.
+    std::mutex printMutex;
+    std::size_t nextToPrint = 0;
+    const auto finish = [&](std::size_t index, Outcome outcome) {
+        std::lock_guard lock(printMutex);
+        outcomes[index] = std::move(outcome);
+        outcomes[index].finished = true;
+        while (nextToPrint < outcomes.size() && outcomes[nextToPrint].finished)
+        {
+            if (textOutput)
+            {
+                printOutcome(inputs[nextToPrint], outcomes[nextToPrint]);
+            }
+            ++nextToPrint;
+        }
+    };
+
+    const std::array solvers{&part1, &part2};
+    const std::array enabled{options.runPart1, options.runPart2};
+    const auto wallStart = std::chrono::steady_clock::now();
+    std::thread reader([&] {
+        for (std::size_t i = 0; i < inputs.size(); ++i)
+        {
+            queue.push(loadInput(i, inputs[i]));
+        }
+        queue.close();
+    });
+
+    // One draining loop per thread of the shared pool (the caller included), so solving
+    // stays within the --threads budget and solvers that use the pool themselves nest safely.
+    parallel::parallelFor(workers, [&](std::size_t) {
+        while (auto loaded = queue.pop())
+        {
+            Outcome outcome;
+            outcome.error = std::move(loaded->error);
+            outcome.bytes = loaded->text.size();
+            outcome.loadSeconds = loaded->loadSeconds;
+            if (outcome.error.empty())
+            {
+                try
+                {
+                    std::optional<InputFile> input;
+                    outcome.parseSeconds = bench::timeSeconds(
+                        [&] { input.emplace(InputFile::fromText(loaded->text, inputs[loaded->index].string())); });
+                    loaded->text = {};
+                    for (std::size_t part = 0; part < solvers.size(); ++part)
+                    {
+                        if (enabled[part])
+                        {
+                            outcome.partSeconds[part] =
+                                bench::timeSeconds([&] { outcome.answers[part] = (*solvers[part])(*input); });
+                        }
+                    }
+                }
+                catch (const std::exception &error)
+                {
+                    outcome.error = error.what();
+                }
+            }
+            finish(loaded->index, std::move(outcome));
+        }
+    });
+    reader.join();
+    const std::chrono::duration<double> wall = std::chrono::steady_clock::now() - wallStart;
+
+    std::size_t failed = 0;
+    std::uintmax_t bytes = 0;
+    double loadSeconds = 0.0;
+    double solveSeconds = 0.0;
+    for (const auto &outcome : outcomes)
+    {
+        failed += outcome.error.empty() ? 0 : 1;
+        bytes += outcome.bytes;
+        loadSeconds += outcome.loadSeconds;
+        solveSeconds += outcome.parseSeconds + outcome.partSeconds[0] + outcome.partSeconds[1];
+    }
+
+    if (!textOutput)
+    {
+        const auto records = batchRecords(dayId, outcomes, options, wall.count());
+        if (options.format == results::Format::Json)
+        {
+            results::writeJson(std::cout, records);
+        }
+        else
+        {
+            results::writeCsv(std::cout, records);
+        }
+        return failed == 0 ? 0 : 1;
+    }
+
+    const double megabytes = static_cast<double>(bytes) / kMegabyte;
+    std::cout << "Solved " << inputs.size() - failed << " of " << inputs.size() << " inputs (" << megabytes
+              << " MB) in " << wall.count() << "s: " << static_cast<double>(inputs.size()) / wall.count()
+              << " inputs/s, " << megabytes / wall.count() << " MB/s" << std::endl;
+    std::cout << "  loading " << loadSeconds << "s on the I/O thread, parsing and solving " << solveSeconds
+              << "s across " << workers << (workers == 1 ? " worker" : " workers") << std::endl;
+    return failed == 0 ? 0 : 1;
+}
+
+} // namespace common::batch
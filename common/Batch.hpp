@@ -0,0 +1,39 @@
+#pragma once
+
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "Config.hpp"
+#include "InputFile.hpp"
+
+namespace common::batch
+{
+/// @brief Files named by --inputs: every regular file of a directory, a glob pattern's
+/// matches, or a single file, sorted by path. Throws std::runtime_error when nothing matches.
+std::vector<std::filesystem::path> expandInputs(std::string_view dirOrGlob);
+
+/// @brief Files listed one per line in listFile (--inputs-from); blank lines and lines
+/// starting with '#' are skipped. Throws std::runtime_error when the list cannot be read.
+std::vector<std::filesystem::path> readInputList(const std::filesystem::path &listFile);
+
+/**
+ * @brief Solves the enabled parts for every input and reports throughput.
+ *
+ * One I/O thread reads the files ahead of the solvers, at most a few per worker, and
+ * threadCount() workers parse and solve them. Answers are printed in input order as they
+ * become available, followed by inputs/s and MB/s over the whole batch; --format=json|csv
+ * instead writes load/parse/part1/part2 records whose samples are the per-input times and a
+ * batch record holding the wall time.
+ *
+ * @return 0 when every input was solved, 1 otherwise.
+ */
+int runBatch(const RunOptions &options,
+             std::string_view dayId,
+             const std::vector<std::filesystem::path> &inputs,
+             const std::function<std::string(const InputFile &)> &part1,
+             const std::function<std::string(const InputFile &)> &part2);
+
+} // namespace common::batch
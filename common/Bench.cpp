@@ -0,0 +1,85 @@
+#include "Bench.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <numeric>
+#include <stdexcept>
+
+namespace common::bench
+{
+namespace
+{
+constexpr double kMillis = 1000.0;
+} // namespace
+
+double quantile(const std::vector<double> &sorted, double q)
+{
+    if (sorted.empty())
+    {
+        throw std::invalid_argument("quantile: no samples");
+    }
+    const double rank = std::clamp(q, 0.0, 1.0) * static_cast<double>(sorted.size() - 1);
+    const auto lower = static_cast<std::size_t>(rank);
+    const std::size_t upper = std::min(lower + 1, sorted.size() - 1);
+    const double fraction = rank - static_cast<double>(lower);
+    return sorted[lower] + (sorted[upper] - sorted[lower]) * fraction;
+}
+
+Summary summarize(std::vector<double> samples)
+{
+    if (samples.empty())
+    {
+        throw std::invalid_argument("summarize: no samples");
+    }
+    std::sort(samples.begin(), samples.end());
+
+    Summary summary;
+    summary.count = samples.size();
+    summary.min = samples.front();
+    summary.max = samples.back();
+    summary.median = quantile(samples, 0.5);
+    summary.p99 = quantile(samples, 0.99);
+    summary.mean = std::accumulate(samples.begin(), samples.end(), 0.0) / static_cast<double>(samples.size());
+    if (samples.size() > 1)
+    {
+        double squares = 0.0;
+        for (const double sample : samples)
+        {
+            squares += (sample - summary.mean) * (sample - summary.mean);
+        }
+        summary.stddev = std::sqrt(squares / static_cast<double>(samples.size() - 1));
+    }
+    return summary;
+}
+
+void printTable(std::ostream &out, const Report &report)
+{
+    out << "Benchmark day " << report.day << ": " << report.runs << " runs after " << report.warmup
+        << " warmup runs (ms)" << '\n';
+    out << "  " << std::left << std::setw(8) << "phase" << std::right;
+    for (const char *column : {"min", "median", "mean", "p99", "stddev"})
+    {
+        out << std::setw(12) << column;
+    }
+    out << '\n';
+
+    const auto flags = out.flags();
+    const auto precision = out.precision();
+    out << std::fixed << std::setprecision(3);
+    for (const auto &phase : report.phases)
+    {
+        const auto summary = summarize(phase.samples);
+        out << "  " << std::left << std::setw(8) << phase.name << std::right;
+        for (const double value : {summary.min, summary.median, summary.mean, summary.p99, summary.stddev})
+        {
+            out << std::setw(12) << value * kMillis;
+        }
+        out << '\n';
+    }
+    out.flags(flags);
+    out.precision(precision);
+    out << std::flush;
+}
+
+} // namespace common::bench
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace common::bench
+{
+/// @brief Order statistics and moments of a set of timing samples, all in seconds.
+struct Summary
+{
+    std::size_t count = 0;
+    double min = 0.0;
+    double median = 0.0;
+    double mean = 0.0;
+    double p99 = 0.0;
+    double max = 0.0;
+    /// Sample standard deviation (n - 1 denominator); 0 for a single sample.
+    double stddev = 0.0;
+};
+
+/// @brief Quantile q in [0, 1] of ascending samples, linearly interpolated between ranks.
+double quantile(const std::vector<double> &sorted, double q);
+
+/// @brief Summarises samples. Throws std::invalid_argument when there are none.
+Summary summarize(std::vector<double> samples);
+
+/// @brief Wall time of one call to body, in seconds, on the steady clock.
+template <typename Body>
+double timeSeconds(Body &&body)
+{
+    const auto start = std::chrono::steady_clock::now();
+    body();
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+}
+
+/// @brief Timings of one benchmark phase: loading the input, parsing it, or solving a part.
+struct Phase
+{
+    std::string name;
+    /// Solver answer for part phases, empty otherwise.
+    std::string result;
+    std::vector<double> samples;
+};
+
+/// @brief Everything a --bench run measured, in phase order.
+struct Report
+{
+    std::string day;
+    std::string input;
+    unsigned warmup = 0;
+    unsigned runs = 0;
+    std::vector<Phase> phases;
+};
+
+/// @brief Human-readable table of min/median/mean/p99/stddev per phase, in milliseconds.
+void printTable(std::ostream &out, const Report &report);
+
+} // namespace common::bench
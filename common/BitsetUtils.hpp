@@ -1,69 +1,469 @@
 #pragma once
 
+#include <algorithm>
+#include <bit>
 #include <bitset>
+#include <concepts>
 #include <cstdint>
 #include <optional>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
+#include "DynamicBitset.hpp"
+
 namespace common::bitset_utils
 {
+namespace detail
+{
+template <std::size_t N>
+constexpr std::size_t bitWidth(const std::bitset<N> &) noexcept
+{
+    return N;
+}
 
-/// @brief Find the minimal subset of bitsets that XOR to the target.
-/// @param candidates Vector of candidate bitsets
-/// @param target The target bitset to achieve via XOR
-/// @return Optional vector of indices of selected candidates.
-/// Returns nullopt if no solution exists.
+inline std::size_t bitWidth(const DynamicBitset &bits) noexcept
+{
+    return bits.size();
+}
+
+/// @brief Bit i of a candidate, treating bits past its width as zero.
+template <typename Bits>
+bool bitAt(const Bits &bits, std::size_t index)
+{
+    return index < bitWidth(bits) && bits[index];
+}
+
+/// @brief Widest of the target and candidates; narrower operands count as zero-padded to it.
+template <typename Bits>
+std::size_t commonWidth(const std::vector<Bits> &candidates, const Bits &target)
+{
+    std::size_t width = bitWidth(target);
+    for (const auto &candidate : candidates)
+    {
+        width = std::max(width, bitWidth(candidate));
+    }
+    return width;
+}
+
+/// @brief bits zero-padded to width. Every std::bitset<N> already has the same width.
 template <std::size_t N>
-std::optional<std::vector<std::size_t>>
-findMinimalXorSubset(const std::vector<std::bitset<N>> &candidates, const std::bitset<N> &target)
+std::bitset<N> padded(const std::bitset<N> &bits, std::size_t)
+{
+    return bits;
+}
+
+inline DynamicBitset padded(const DynamicBitset &bits, std::size_t width)
+{
+    if (bits.size() == width)
+    {
+        return bits;
+    }
+    DynamicBitset wide(width);
+    for (std::size_t index = 0; index < bits.size(); ++index)
+    {
+        if (bits[index])
+        {
+            wide.set(index);
+        }
+    }
+    return wide;
+}
+} // namespace detail
+
+/// @brief Bitset types the XOR subset search accepts: std::bitset<N> or common::DynamicBitset.
+template <typename Bits>
+concept XorBitset = requires(Bits lhs, const Bits rhs, std::size_t index) {
+    lhs ^= rhs;
+    lhs.reset();
+    { rhs[index] } -> std::convertible_to<bool>;
+    { rhs == rhs } -> std::convertible_to<bool>;
+    { detail::bitWidth(rhs) } -> std::convertible_to<std::size_t>;
+};
+
+/// @brief Nullity up to which the solution coset is enumerated exhaustively.
+/// Larger nullspaces fall back to a meet-in-the-middle search over the pivot space.
+inline constexpr std::size_t kMaxEnumeratedNullity = 20;
+
+/// @brief A GF(2) system "XOR of chosen candidates == target" in reduced row-echelon form.
+/// Every solution is x = particular + sum of the free columns picked; the vectors below are
+/// expressed in pivot space, i.e. bit r is the value of the r-th pivot variable.
+struct XorSystem
+{
+    std::size_t variables = 0;
+    bool consistent = true;
+    std::vector<std::size_t> pivotColumns;
+    std::vector<std::size_t> freeColumns;
+    /// @brief Pivot variables when every free variable is zero.
+    DynamicBitset particular;
+    /// @brief For each free column, the pivot variables it toggles when set.
+    std::vector<DynamicBitset> freeImages;
+
+    std::size_t rank() const noexcept { return pivotColumns.size(); }
+    std::size_t nullity() const noexcept { return freeColumns.size(); }
+};
+
+/// @brief Reduce the candidates/target system to reduced row-echelon form over GF(2).
+/// Each bit position of the bitsets is one equation; each candidate is one variable.
+template <XorBitset Bits>
+XorSystem reduceXorSystem(const std::vector<Bits> &candidates, const Bits &target)
 {
     const std::size_t n = candidates.size();
-    if (n == 0)
+    const std::size_t rhsColumn = n;
+    const std::size_t width = detail::commonWidth(candidates, target);
+
+    // One row per bit position: which candidates toggle it, plus the target bit.
+    std::vector<DynamicBitset> rows;
+    rows.reserve(width);
+    for (std::size_t bit = 0; bit < width; ++bit)
     {
-        return target.none() ? std::optional<std::vector<std::size_t>>(std::vector<std::size_t>{}) : std::nullopt;
+        DynamicBitset row(n + 1);
+        bool nonZero = false;
+        for (std::size_t col = 0; col < n; ++col)
+        {
+            if (detail::bitAt(candidates[col], bit))
+            {
+                row.flip(col);
+                nonZero = true;
+            }
+        }
+        if (detail::bitAt(target, bit))
+        {
+            row.flip(rhsColumn);
+            nonZero = true;
+        }
+        if (nonZero)
+        {
+            rows.push_back(std::move(row));
+        }
     }
-    
-    // Brute force: iterate through all 2^n subsets, ordered by popcount (subset size)
-    // For small n this is fine; for n > 20 would need a smarter approach
-    const uint64_t totalSubsets = 1ULL << n;
-    
-    // Try subsets in order of increasing size
-    for (std::size_t subsetSize = 0; subsetSize <= n; ++subsetSize)
+
+    XorSystem system;
+    system.variables = n;
+    std::size_t pivotRow = 0;
+    for (std::size_t col = 0; col < n; ++col)
     {
-        for (uint64_t mask = 0; mask < totalSubsets; ++mask)
+        std::size_t found = pivotRow;
+        while (found < rows.size() && !rows[found][col])
+        {
+            ++found;
+        }
+        if (found == rows.size())
+        {
+            system.freeColumns.push_back(col);
+            continue;
+        }
+
+        std::swap(rows[pivotRow], rows[found]);
+        for (std::size_t row = 0; row < rows.size(); ++row)
         {
-            // Skip if this mask doesn't have exactly subsetSize bits set
-            if (static_cast<std::size_t>(__builtin_popcountll(mask)) != subsetSize)
+            if (row != pivotRow && rows[row][col])
             {
-                continue;
+                rows[row] ^= rows[pivotRow];
             }
-            
-            // Compute XOR of selected candidates
-            std::bitset<N> xorResult;
-            for (std::size_t i = 0; i < n; ++i)
+        }
+        system.pivotColumns.push_back(col);
+        ++pivotRow;
+    }
+
+    // Remaining rows read 0 == rhs; a set rhs bit means no subset reaches the target.
+    for (std::size_t row = pivotRow; row < rows.size(); ++row)
+    {
+        if (rows[row][rhsColumn])
+        {
+            system.consistent = false;
+        }
+    }
+
+    const std::size_t rank = system.rank();
+    system.particular = DynamicBitset(rank);
+    system.freeImages.assign(system.freeColumns.size(), DynamicBitset(rank));
+    for (std::size_t r = 0; r < rank; ++r)
+    {
+        if (rows[r][rhsColumn])
+        {
+            system.particular.flip(r);
+        }
+        for (std::size_t f = 0; f < system.freeColumns.size(); ++f)
+        {
+            if (rows[r][system.freeColumns[f]])
             {
-                if (mask & (1ULL << i))
-                {
-                    xorResult ^= candidates[i];
-                }
+                system.freeImages[f].flip(r);
             }
-            
-            // Check if we found the target
-            if (xorResult == target)
+        }
+    }
+    return system;
+}
+
+namespace detail
+{
+/// @brief Expands a free-variable choice and pivot values into sorted candidate indices.
+inline std::vector<std::size_t> solutionIndices(const XorSystem &system,
+                                                const std::vector<std::size_t> &chosenFree,
+                                                const DynamicBitset &pivotValues)
+{
+    std::vector<std::size_t> indices;
+    for (const std::size_t f : chosenFree)
+    {
+        indices.push_back(system.freeColumns[f]);
+    }
+    for (std::size_t r = 0; r < system.rank(); ++r)
+    {
+        if (pivotValues[r])
+        {
+            indices.push_back(system.pivotColumns[r]);
+        }
+    }
+    std::sort(indices.begin(), indices.end());
+    return indices;
+}
+
+/// @brief Exhaustive walk over all 2^k free assignments (k = nullity).
+/// Assignments are visited in Gray-code order, so each step flips one free variable and
+/// costs a single XOR of its image instead of rebuilding the pivot values from scratch.
+inline std::vector<std::size_t> enumerateNullspace(const XorSystem &system)
+{
+    const std::size_t k = system.nullity();
+    DynamicBitset pivots = system.particular;
+    std::size_t bestWeight = pivots.count();
+    uint64_t bestMask = 0;
+
+    uint64_t gray = 0;
+    for (uint64_t step = 1; step < (uint64_t{1} << k); ++step)
+    {
+        const auto flipped = static_cast<std::size_t>(std::countr_zero(step));
+        gray ^= uint64_t{1} << flipped;
+        pivots ^= system.freeImages[flipped];
+        const std::size_t weight = static_cast<std::size_t>(std::popcount(gray)) + pivots.count();
+        if (weight < bestWeight)
+        {
+            bestWeight = weight;
+            bestMask = gray;
+        }
+    }
+
+    std::vector<std::size_t> chosen;
+    pivots = system.particular;
+    for (std::size_t f = 0; f < k; ++f)
+    {
+        if (bestMask & (uint64_t{1} << f))
+        {
+            chosen.push_back(f);
+            pivots ^= system.freeImages[f];
+        }
+    }
+    return solutionIndices(system, chosen, pivots);
+}
+
+/// @brief Meet-in-the-middle search for large nullspaces.
+/// Picking a free column XORs its image into the pivot values; setting a pivot variable
+/// directly toggles a single pivot bit. The cheapest solution is therefore the shortest
+/// path from 0 to `particular` in the Cayley graph over pivot space whose generators are
+/// the free images plus the unit vectors. A bidirectional BFS meets in the middle, so it
+/// only explores about half the depth from each side and never touches the 2^k cosets.
+inline std::vector<std::size_t> meetInTheMiddle(const XorSystem &system)
+{
+    struct Visit
+    {
+        std::size_t depth;
+        DynamicBitset parent;
+        std::size_t generator; // < nullity: free column, otherwise nullity + pivot row
+    };
+    using VisitMap = std::unordered_map<DynamicBitset, Visit>;
+
+    const std::size_t k = system.nullity();
+    const std::size_t generators = k + system.rank();
+    const DynamicBitset zero(system.rank());
+
+    auto applyGenerator = [&](DynamicBitset state, std::size_t generator) {
+        if (generator < k)
+        {
+            state ^= system.freeImages[generator];
+        }
+        else
+        {
+            state.flip(generator - k);
+        }
+        return state;
+    };
+
+    VisitMap forward{{zero, {0, {}, 0}}};
+    VisitMap backward{{system.particular, {0, {}, 0}}};
+    std::vector<DynamicBitset> forwardFrontier{zero};
+    std::vector<DynamicBitset> backwardFrontier{system.particular};
+
+    std::optional<DynamicBitset> meeting;
+    if (forward.contains(system.particular))
+    {
+        meeting.emplace(zero);
+    }
+    while (!meeting && !forwardFrontier.empty() && !backwardFrontier.empty())
+    {
+        const bool expandForward = forwardFrontier.size() <= backwardFrontier.size();
+        auto &frontier = expandForward ? forwardFrontier : backwardFrontier;
+        auto &visited = expandForward ? forward : backward;
+        const auto &other = expandForward ? backward : forward;
+
+        std::size_t bestTotal = generators + 1;
+        std::vector<DynamicBitset> next;
+        for (const auto &state : frontier)
+        {
+            const std::size_t depth = visited.at(state).depth + 1;
+            for (std::size_t g = 0; g < generators; ++g)
             {
-                std::vector<std::size_t> indices;
-                for (std::size_t i = 0; i < n; ++i)
+                auto neighbour = applyGenerator(state, g);
+                if (visited.contains(neighbour))
+                {
+                    continue;
+                }
+                visited.emplace(neighbour, Visit{depth, state, g});
+                if (const auto it = other.find(neighbour); it != other.end())
                 {
-                    if (mask & (1ULL << i))
+                    // Finish the level and keep the cheapest join; the other side mixes depths.
+                    if (depth + it->second.depth < bestTotal)
                     {
-                        indices.push_back(i);
+                        bestTotal = depth + it->second.depth;
+                        meeting = neighbour;
                     }
                 }
-                return indices;
+                next.push_back(std::move(neighbour));
+            }
+        }
+        frontier = std::move(next);
+    }
+
+    if (!meeting)
+    {
+        throw std::runtime_error("XOR system is consistent but no path to the target was found");
+    }
+
+    // Walk both halves back to their roots, collecting generators.
+    std::vector<bool> used(generators, false);
+    for (const auto *visited : {&forward, &backward})
+    {
+        DynamicBitset state = *meeting;
+        for (auto it = visited->find(state); it->second.depth > 0; it = visited->find(state))
+        {
+            used[it->second.generator] = !used[it->second.generator];
+            state = it->second.parent;
+        }
+    }
+
+    std::vector<std::size_t> chosen;
+    DynamicBitset pivots(system.rank());
+    for (std::size_t g = 0; g < generators; ++g)
+    {
+        if (!used[g])
+        {
+            continue;
+        }
+        if (g < k)
+        {
+            chosen.push_back(g);
+        }
+        else
+        {
+            pivots.flip(g - k);
+        }
+    }
+    return solutionIndices(system, chosen, pivots);
+}
+} // namespace detail
+
+/// @brief Minimum-weight solution of a reduced system as sorted candidate indices.
+/// Returns nullopt if the system is inconsistent.
+inline std::optional<std::vector<std::size_t>> minimalWeightSolution(const XorSystem &system)
+{
+    if (!system.consistent)
+    {
+        return std::nullopt;
+    }
+    if (system.nullity() <= kMaxEnumeratedNullity)
+    {
+        return detail::enumerateNullspace(system);
+    }
+    return detail::meetInTheMiddle(system);
+}
+
+/// @brief Find the minimal subset of bitsets that XOR to the target.
+/// The system is reduced with GF(2) elimination first, so only the 2^k combinations of the
+/// nullspace (k = nullity) are searched instead of every subset of the candidates.
+/// @param candidates Vector of candidate bitsets
+/// @param target The target bitset to achieve via XOR
+/// @return Optional vector of indices of selected candidates.
+/// Returns nullopt if no solution exists.
+template <XorBitset Bits>
+std::optional<std::vector<std::size_t>>
+findMinimalXorSubset(const std::vector<Bits> &candidates, const Bits &target)
+{
+    return minimalWeightSolution(reduceXorSystem(candidates, target));
+}
+
+/// @brief Reference brute force over all 2^n subsets (only usable for small n).
+/// Masks are walked in Gray-code order so each step XORs a single candidate, and the first
+/// mask seen for every popcount is recorded, covering all subset sizes in one pass.
+/// Kept to cross-check the elimination-based search, so operands of different widths are
+/// zero-padded to the widest one, as reduceXorSystem treats them.
+template <XorBitset Bits>
+std::optional<std::vector<std::size_t>>
+findMinimalXorSubsetExhaustive(const std::vector<Bits> &inputCandidates, const Bits &inputTarget)
+{
+    const std::size_t n = inputCandidates.size();
+    if (n >= 64)
+    {
+        throw std::length_error("findMinimalXorSubsetExhaustive supports at most 63 candidates");
+    }
+    const std::size_t width = detail::commonWidth(inputCandidates, inputTarget);
+    std::vector<Bits> candidates;
+    candidates.reserve(n);
+    for (const auto &candidate : inputCandidates)
+    {
+        candidates.push_back(detail::padded(candidate, width));
+    }
+    const Bits target = detail::padded(inputTarget, width);
+
+    // bestBySize[s] holds the first mask of popcount s whose XOR hits the target.
+    std::vector<std::optional<uint64_t>> bestBySize(n + 1);
+    Bits xorResult = target;
+    xorResult.reset();
+    uint64_t gray = 0;
+    if (xorResult == target)
+    {
+        bestBySize[0] = gray;
+    }
+    for (uint64_t step = 1; step < (uint64_t{1} << n); ++step)
+    {
+        const auto flipped = static_cast<std::size_t>(std::countr_zero(step));
+        gray ^= uint64_t{1} << flipped;
+        xorResult ^= candidates[flipped];
+        if (xorResult == target)
+        {
+            auto &slot = bestBySize[static_cast<std::size_t>(std::popcount(gray))];
+            if (!slot)
+            {
+                slot = gray;
             }
         }
     }
-    
+
+    for (const auto &mask : bestBySize)
+    {
+        if (!mask)
+        {
+            continue;
+        }
+        std::vector<std::size_t> indices;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            if (*mask & (uint64_t{1} << i))
+            {
+                indices.push_back(i);
+            }
+        }
+        return indices;
+    }
+
     return std::nullopt;
 }
 
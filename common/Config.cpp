@@ -1,5 +1,7 @@
 #include "Config.hpp"
 
+#include <atomic>
+#include <charconv>
 #include <cstdlib>
 #include <filesystem>
 #include <iostream>
@@ -17,6 +19,16 @@ constexpr std::string_view kSkipPart1Env = "AOC_SKIP_PART1";
 constexpr std::string_view kSkipPart2Env = "AOC_SKIP_PART2";
 constexpr std::string_view kOnlyPartEnv = "AOC_ONLY_PART";
 constexpr std::string_view kColorEnv = "AOC_COLOR";
+constexpr std::string_view kThreadsEnv = "AOC_THREADS";
+constexpr std::string_view kVerboseEnv = "AOC_VERBOSE";
+constexpr std::string_view kParallelPartsEnv = "AOC_PARALLEL_PARTS";
+constexpr std::string_view kBenchEnv = "AOC_BENCH";
+constexpr std::string_view kPerfEnv = "AOC_PERF";
+constexpr std::string_view kAllocEnv = "AOC_ALLOC";
+constexpr std::string_view kFormatEnv = "AOC_FORMAT";
+constexpr unsigned kDefaultBenchRuns = 10;
+
+std::atomic<bool> g_verbose{false};
 
 bool parseBoolEnv(const char *value, bool defaultValue)
 {
@@ -58,7 +70,65 @@ bool isCustomFlag(std::string_view arg)
            arg == "--puzzle-only" ||
            arg == "--skip-part1" || arg == "--skip-part2" ||
            arg == "--only-part1" || arg == "--only-part2" ||
-           arg == "--no-color" || arg == "--color";
+           arg == "--no-color" || arg == "--color" ||
+           arg.starts_with("--threads=") || arg == "--threads" ||
+           arg == "--verbose" || arg == "--parallel-parts" ||
+           arg.starts_with("--bench=") || arg == "--bench" ||
+           arg.starts_with("--bench-warmup=") || arg == "--bench-warmup" ||
+           arg.starts_with("--bench-json=") || arg == "--bench-json" ||
+           arg == "--perf" || arg == "--alloc" ||
+           arg.starts_with("--format=") || arg == "--format" ||
+           arg.starts_with("--generate=") || arg == "--generate" ||
+           arg.starts_with("--seed=") || arg == "--seed" ||
+           arg.starts_with("--output=") || arg == "--output" ||
+           arg.starts_with("--serve=") || arg == "--serve" ||
+           arg.starts_with("--inputs=") || arg == "--inputs" ||
+           arg.starts_with("--inputs-from=") || arg == "--inputs-from";
+}
+
+unsigned parseCount(std::string_view value, std::string_view what, unsigned fallback)
+{
+    unsigned count = 0;
+    const auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), count);
+    if (ec != std::errc() || ptr != value.data() + value.size())
+    {
+        std::cerr << "Invalid " << what << ": " << value << std::endl;
+        return fallback;
+    }
+    return count;
+}
+
+uint64_t parseSeed(std::string_view value, uint64_t fallback)
+{
+    uint64_t seed = 0;
+    const auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), seed);
+    if (ec != std::errc() || ptr != value.data() + value.size())
+    {
+        std::cerr << "Invalid seed: " << value << std::endl;
+        return fallback;
+    }
+    return seed;
+}
+
+results::Format parseFormatName(std::string_view value, results::Format fallback)
+{
+    if (const auto format = results::parseFormat(value))
+    {
+        return *format;
+    }
+    std::cerr << "Unknown output format: " << value << " (expected text, json or csv)" << std::endl;
+    return fallback;
+}
+
+unsigned parseThreadCount(std::string_view value)
+{
+    return parseCount(value, "thread count", 0);
+}
+
+unsigned parseBenchRuns(std::string_view value)
+{
+    const unsigned runs = parseCount(value, "benchmark run count", kDefaultBenchRuns);
+    return runs == 0 ? kDefaultBenchRuns : runs;
 }
 
 void compactArguments(int &argc, char **argv, const std::vector<int> &skipIndices)
@@ -163,6 +233,22 @@ RunOptions buildRunOptions(std::string_view dayId,
     }
 
     options.colorOutput = parseBoolEnv(std::getenv(std::string(kColorEnv).c_str()), true);
+    options.verbose = parseBoolEnv(std::getenv(std::string(kVerboseEnv).c_str()), false);
+    options.parallelParts = parseBoolEnv(std::getenv(std::string(kParallelPartsEnv).c_str()), false);
+    options.perf = parseBoolEnv(std::getenv(std::string(kPerfEnv).c_str()), false);
+    options.allocations = parseBoolEnv(std::getenv(std::string(kAllocEnv).c_str()), false);
+    if (const char *envThreads = std::getenv(std::string(kThreadsEnv).c_str()))
+    {
+        options.threads = parseThreadCount(envThreads);
+    }
+    if (const char *envFormat = std::getenv(std::string(kFormatEnv).c_str()))
+    {
+        options.format = parseFormatName(envFormat, options.format);
+    }
+    if (const char *envBench = std::getenv(std::string(kBenchEnv).c_str()))
+    {
+        options.benchRuns = parseBenchRuns(envBench);
+    }
 
     std::vector<int> consumedArgs;
     for (int i = 1; i < argc; ++i)
@@ -269,13 +355,199 @@ RunOptions buildRunOptions(std::string_view dayId,
         {
             options.colorOutput = true;
         }
+        else if (arg.starts_with("--threads="))
+        {
+            options.threads = parseThreadCount(arg.substr(std::string_view("--threads=").size()));
+        }
+        else if (arg == "--threads")
+        {
+            if (i + 1 < argc)
+            {
+                consumedArgs.push_back(i + 1);
+                options.threads = parseThreadCount(argv[++i]);
+            }
+            else
+            {
+                std::cerr << "Missing value for --threads flag" << std::endl;
+            }
+        }
+        else if (arg == "--verbose")
+        {
+            options.verbose = true;
+        }
+        else if (arg == "--parallel-parts")
+        {
+            options.parallelParts = true;
+        }
+        else if (arg == "--perf")
+        {
+            options.perf = true;
+        }
+        else if (arg == "--alloc")
+        {
+            options.allocations = true;
+        }
+        else if (arg.starts_with("--format="))
+        {
+            options.format = parseFormatName(arg.substr(std::string_view("--format=").size()), options.format);
+        }
+        else if (arg == "--format")
+        {
+            if (i + 1 < argc)
+            {
+                consumedArgs.push_back(i + 1);
+                options.format = parseFormatName(argv[++i], options.format);
+            }
+            else
+            {
+                std::cerr << "Missing value for --format flag" << std::endl;
+            }
+        }
+        else if (arg == "--generate")
+        {
+            options.generateScale = 1;
+        }
+        else if (arg.starts_with("--generate="))
+        {
+            const unsigned scale = parseCount(arg.substr(std::string_view("--generate=").size()), "generator scale", 1);
+            options.generateScale = scale == 0 ? 1 : scale;
+        }
+        else if (arg.starts_with("--seed="))
+        {
+            options.generateSeed = parseSeed(arg.substr(std::string_view("--seed=").size()), options.generateSeed);
+        }
+        else if (arg == "--seed")
+        {
+            if (i + 1 < argc)
+            {
+                consumedArgs.push_back(i + 1);
+                options.generateSeed = parseSeed(argv[++i], options.generateSeed);
+            }
+            else
+            {
+                std::cerr << "Missing value for --seed flag" << std::endl;
+            }
+        }
+        else if (arg.starts_with("--output="))
+        {
+            options.generateOutput = arg.substr(std::string_view("--output=").size());
+        }
+        else if (arg == "--output")
+        {
+            if (i + 1 < argc)
+            {
+                consumedArgs.push_back(i + 1);
+                options.generateOutput = argv[++i];
+            }
+            else
+            {
+                std::cerr << "Missing value for --output flag" << std::endl;
+            }
+        }
+        else if (arg == "--serve")
+        {
+            options.serve = true;
+        }
+        else if (arg.starts_with("--serve="))
+        {
+            options.serve = true;
+            options.serveSocket = arg.substr(std::string_view("--serve=").size());
+        }
+        else if (arg.starts_with("--inputs="))
+        {
+            options.batchInputs = arg.substr(std::string_view("--inputs=").size());
+        }
+        else if (arg == "--inputs")
+        {
+            if (i + 1 < argc)
+            {
+                consumedArgs.push_back(i + 1);
+                options.batchInputs = argv[++i];
+            }
+            else
+            {
+                std::cerr << "Missing value for --inputs flag" << std::endl;
+            }
+        }
+        else if (arg.starts_with("--inputs-from="))
+        {
+            options.batchInputsFrom = arg.substr(std::string_view("--inputs-from=").size());
+        }
+        else if (arg == "--inputs-from")
+        {
+            if (i + 1 < argc)
+            {
+                consumedArgs.push_back(i + 1);
+                options.batchInputsFrom = argv[++i];
+            }
+            else
+            {
+                std::cerr << "Missing value for --inputs-from flag" << std::endl;
+            }
+        }
+        else if (arg == "--bench")
+        {
+            options.benchRuns = kDefaultBenchRuns;
+        }
+        else if (arg.starts_with("--bench="))
+        {
+            options.benchRuns = parseBenchRuns(arg.substr(std::string_view("--bench=").size()));
+        }
+        else if (arg.starts_with("--bench-warmup="))
+        {
+            options.benchWarmup = parseCount(arg.substr(std::string_view("--bench-warmup=").size()),
+                                             "benchmark warmup count", options.benchWarmup);
+        }
+        else if (arg == "--bench-warmup")
+        {
+            if (i + 1 < argc)
+            {
+                consumedArgs.push_back(i + 1);
+                options.benchWarmup = parseCount(argv[++i], "benchmark warmup count", options.benchWarmup);
+            }
+            else
+            {
+                std::cerr << "Missing value for --bench-warmup flag" << std::endl;
+            }
+        }
+        else if (arg.starts_with("--bench-json="))
+        {
+            options.benchJsonPath = arg.substr(std::string_view("--bench-json=").size());
+        }
+        else if (arg == "--bench-json")
+        {
+            if (i + 1 < argc)
+            {
+                consumedArgs.push_back(i + 1);
+                options.benchJsonPath = argv[++i];
+            }
+            else
+            {
+                std::cerr << "Missing value for --bench-json flag" << std::endl;
+            }
+        }
     }
 
     compactArguments(argc, argv, consumedArgs);
 
+    if (!options.benchJsonPath.empty() && options.benchRuns == 0)
+    {
+        options.benchRuns = kDefaultBenchRuns;
+    }
+
     options.inputPath = canonicalizeOrFallback(options.inputPath, resolveInputPath(dayId, sourcePath));
     options.testsPath = canonicalizeOrFallback(options.testsPath, resolveTestsPath(dayId, sourcePath));
     return options;
 }
 
+void setVerbose(bool enabled)
+{
+    g_verbose = enabled;
+}
+
+bool isVerbose()
+{
+    return g_verbose;
+}
+
 } // namespace common
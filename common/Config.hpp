@@ -1,9 +1,12 @@
 #pragma once
 
+#include <cstdint>
 #include <filesystem>
 #include <string>
 #include <string_view>
 
+#include "Results.hpp"
+
 namespace common
 {
 struct RunOptions
@@ -13,6 +16,38 @@ struct RunOptions
     bool colorOutput = true;
     bool samplesOnly = false;
     bool inputOnly = false;
+    /// Worker threads for parallel helpers (0 = hardware concurrency).
+    unsigned threads = 0;
+    /// Emit per-item solver diagnostics to stderr.
+    bool verbose = false;
+    /// Run part 1 and part 2 of the puzzle input on separate threads.
+    bool parallelParts = false;
+    /// Report hardware performance counters for each part.
+    bool perf = false;
+    /// Count heap allocations and report peak memory for each part.
+    bool allocations = false;
+    /// Output format for results and timings on stdout.
+    results::Format format = results::Format::Text;
+    /// Timed repetitions per phase in benchmark mode (0 = no benchmark).
+    unsigned benchRuns = 0;
+    /// Untimed runs before the benchmark repetitions.
+    unsigned benchWarmup = 3;
+    /// Where to write the benchmark report as JSON ("-" for stdout, empty for none).
+    std::filesystem::path benchJsonPath;
+    /// Write a synthetic input at this scale instead of solving (0 = no generation).
+    unsigned generateScale = 0;
+    /// Seed of the synthetic input; the same seed and scale give the same file.
+    uint64_t generateSeed = 1;
+    /// Where to write the synthetic input ("-" or empty for stdout).
+    std::filesystem::path generateOutput;
+    /// Answer solve requests from a long-lived process instead of running once.
+    bool serve = false;
+    /// Unix domain socket for --serve; empty serves stdin/stdout.
+    std::filesystem::path serveSocket;
+    /// Directory or glob of inputs to solve in one batch (--inputs); empty for none.
+    std::string batchInputs;
+    /// File listing one batch input per line (--inputs-from); empty for none.
+    std::filesystem::path batchInputsFrom;
     std::filesystem::path inputPath;
     std::filesystem::path testsPath;
 };
@@ -34,4 +69,8 @@ std::filesystem::path resolveTestsPath(std::string_view dayId, std::string_view
 
 /// Returns the directory that contains the calling source file (useful for tests).
 std::filesystem::path deduceDayDirectory(std::string_view anchorPath);
+
+/// Process-wide verbose flag; the runner sets it from RunOptions::verbose.
+void setVerbose(bool enabled);
+bool isVerbose();
 }
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <filesystem>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Generator.hpp"
+#include "InputFile.hpp"
+#include "SolverContext.hpp"
+
+namespace common
+{
+/// @brief One day's solvers, type-erased to the runner's string interface.
+struct DayEntry
+{
+    /// Two-digit day number, e.g. "04".
+    std::string id;
+    /// The day's source directory; its input.txt is the default puzzle input.
+    std::filesystem::path directory;
+    std::function<std::string(const InputFile &)> part1;
+    std::function<std::string(const InputFile &)> part2;
+    /// Writes a synthetic input for the day; empty if it has none.
+    gen::Generator generate;
+};
+
+/// @brief The days linked into an aggregate driver such as aoc-all, in registration order.
+class DayRegistry
+{
+public:
+    /// @brief Registers a day. Solvers may take (const InputFile &) or
+    /// (const InputFile &, SolverContext &), exactly as for common::runDay.
+    template <typename Part1Fn, typename Part2Fn>
+    void add(std::string id,
+             std::filesystem::path directory,
+             Part1Fn &&part1,
+             Part2Fn &&part2,
+             gen::Generator generate = {})
+    {
+        const std::string label = "Day " + id;
+        auto part1Adapter = [label, part1Fn = std::forward<Part1Fn>(part1)](const InputFile &input) {
+            return detail::invokeSolver(part1Fn, input, label + " Part 1");
+        };
+        auto part2Adapter = [label, part2Fn = std::forward<Part2Fn>(part2)](const InputFile &input) {
+            return detail::invokeSolver(part2Fn, input, label + " Part 2");
+        };
+        m_days.push_back({std::move(id),
+                          std::move(directory),
+                          std::move(part1Adapter),
+                          std::move(part2Adapter),
+                          std::move(generate)});
+    }
+
+    const std::vector<DayEntry> &days() const noexcept { return m_days; }
+
+private:
+    std::vector<DayEntry> m_days;
+};
+
+} // namespace common
@@ -0,0 +1,350 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace common
+{
+/// @brief Bitset whose width is chosen at runtime.
+/// Bits are packed into 64-bit words. Widths of 64 bits or less live in an inline word
+/// and never allocate; wider sets spill to the heap. The inline word and the heap pointer
+/// share a union, so the object is just the width plus one word. Bulk operations work a
+/// word at a time and use AVX2 for wide sets when the compiler targets it.
+class DynamicBitset
+{
+public:
+    using Word = uint64_t;
+    static constexpr std::size_t kWordBits = 64;
+
+    DynamicBitset() = default;
+
+    explicit DynamicBitset(std::size_t bits) : m_bits(bits)
+    {
+        if (!isInline())
+        {
+            m_words.heap = new Word[wordCount()]();
+        }
+    }
+
+    DynamicBitset(const DynamicBitset &other) : m_bits(other.m_bits), m_words(other.m_words)
+    {
+        if (!isInline())
+        {
+            m_words.heap = new Word[wordCount()];
+            std::copy_n(other.m_words.heap, wordCount(), m_words.heap);
+        }
+    }
+
+    DynamicBitset(DynamicBitset &&other) noexcept
+        : m_bits(std::exchange(other.m_bits, 0)), m_words(std::exchange(other.m_words, Words{}))
+    {
+    }
+
+    DynamicBitset &operator=(const DynamicBitset &other)
+    {
+        if (this == &other)
+        {
+            return *this;
+        }
+        if (!isInline() && wordCount() == other.wordCount())
+        {
+            // Same number of heap words: reuse the buffer.
+            m_bits = other.m_bits;
+            std::copy_n(other.m_words.heap, wordCount(), m_words.heap);
+            return *this;
+        }
+        DynamicBitset copy(other);
+        swap(copy);
+        return *this;
+    }
+
+    DynamicBitset &operator=(DynamicBitset &&other) noexcept
+    {
+        DynamicBitset moved(std::move(other));
+        swap(moved);
+        return *this;
+    }
+
+    ~DynamicBitset()
+    {
+        if (!isInline())
+        {
+            delete[] m_words.heap;
+        }
+    }
+
+    void swap(DynamicBitset &other) noexcept
+    {
+        std::swap(m_bits, other.m_bits);
+        std::swap(m_words, other.m_words);
+    }
+
+    /// @brief Parse a string where character i maps to bit i (leftmost character is bit 0).
+    static DynamicBitset fromString(std::string_view text, char zero = '0', char one = '1')
+    {
+        DynamicBitset bits(text.size());
+        for (std::size_t i = 0; i < text.size(); ++i)
+        {
+            if (text[i] == one)
+            {
+                bits.setUnchecked(i);
+            }
+            else if (text[i] != zero)
+            {
+                throw std::invalid_argument("DynamicBitset::fromString: unexpected character");
+            }
+        }
+        return bits;
+    }
+
+    std::size_t size() const noexcept { return m_bits; }
+    std::size_t wordCount() const noexcept { return (m_bits + kWordBits - 1) / kWordBits; }
+
+    Word *data() noexcept { return isInline() ? &m_words.inlineWord : m_words.heap; }
+    const Word *data() const noexcept { return isInline() ? &m_words.inlineWord : m_words.heap; }
+
+    bool operator[](std::size_t index) const noexcept
+    {
+        return (data()[index / kWordBits] >> (index % kWordBits)) & 1U;
+    }
+
+    bool test(std::size_t index) const
+    {
+        checkIndex(index);
+        return (*this)[index];
+    }
+
+    DynamicBitset &set(std::size_t index, bool value = true)
+    {
+        checkIndex(index);
+        if (value)
+        {
+            setUnchecked(index);
+        }
+        else
+        {
+            data()[index / kWordBits] &= ~bitMask(index);
+        }
+        return *this;
+    }
+
+    DynamicBitset &reset(std::size_t index) { return set(index, false); }
+
+    /// @brief Clears every bit while keeping the width.
+    DynamicBitset &reset() noexcept
+    {
+        std::fill_n(data(), wordCount(), Word{0});
+        return *this;
+    }
+
+    DynamicBitset &flip(std::size_t index)
+    {
+        checkIndex(index);
+        data()[index / kWordBits] ^= bitMask(index);
+        return *this;
+    }
+
+    std::size_t count() const noexcept
+    {
+        if (isInline())
+        {
+            return static_cast<std::size_t>(std::popcount(m_words.inlineWord));
+        }
+        const Word *words = data();
+        std::size_t total = 0;
+        for (std::size_t i = 0; i < wordCount(); ++i)
+        {
+            total += static_cast<std::size_t>(std::popcount(words[i]));
+        }
+        return total;
+    }
+
+    bool none() const noexcept
+    {
+        const Word *words = data();
+        return std::all_of(words, words + wordCount(), [](Word word) { return word == 0; });
+    }
+
+    bool any() const noexcept { return !none(); }
+
+    DynamicBitset &operator^=(const DynamicBitset &other)
+    {
+        return apply<BulkOp::Xor>(other);
+    }
+
+    DynamicBitset &operator&=(const DynamicBitset &other)
+    {
+        return apply<BulkOp::And>(other);
+    }
+
+    DynamicBitset &operator|=(const DynamicBitset &other)
+    {
+        return apply<BulkOp::Or>(other);
+    }
+
+    friend DynamicBitset operator^(DynamicBitset lhs, const DynamicBitset &rhs) { return lhs ^= rhs; }
+    friend DynamicBitset operator&(DynamicBitset lhs, const DynamicBitset &rhs) { return lhs &= rhs; }
+    friend DynamicBitset operator|(DynamicBitset lhs, const DynamicBitset &rhs) { return lhs |= rhs; }
+
+    bool operator==(const DynamicBitset &other) const noexcept
+    {
+        return m_bits == other.m_bits && std::equal(data(), data() + wordCount(), other.data());
+    }
+
+    /// @brief Renders bit 0 first, matching fromString.
+    std::string toString(char zero = '0', char one = '1') const
+    {
+        std::string text(m_bits, zero);
+        for (std::size_t i = 0; i < m_bits; ++i)
+        {
+            if ((*this)[i])
+            {
+                text[i] = one;
+            }
+        }
+        return text;
+    }
+
+private:
+    /// The inline word while the width fits in one word, the heap buffer otherwise.
+    union Words
+    {
+        Word inlineWord = 0;
+        Word *heap;
+    };
+
+    bool isInline() const noexcept { return m_bits <= kWordBits; }
+
+    static constexpr Word bitMask(std::size_t index) noexcept { return Word{1} << (index % kWordBits); }
+
+    void setUnchecked(std::size_t index) noexcept { data()[index / kWordBits] |= bitMask(index); }
+
+    void checkIndex(std::size_t index) const
+    {
+        if (index >= m_bits)
+        {
+            throw std::out_of_range("DynamicBitset index out of range");
+        }
+    }
+
+    [[noreturn, gnu::cold, gnu::noinline]] static void throwWidthMismatch()
+    {
+        throw std::invalid_argument("DynamicBitset width mismatch");
+    }
+
+    enum class BulkOp
+    {
+        Xor,
+        And,
+        Or
+    };
+
+    template <BulkOp Op>
+    static Word combine(Word lhs, Word rhs) noexcept
+    {
+        if constexpr (Op == BulkOp::Xor)
+        {
+            return lhs ^ rhs;
+        }
+        else if constexpr (Op == BulkOp::And)
+        {
+            return lhs & rhs;
+        }
+        else
+        {
+            return lhs | rhs;
+        }
+    }
+
+#if defined(__AVX2__)
+    template <BulkOp Op>
+    static __m256i combine(__m256i lhs, __m256i rhs) noexcept
+    {
+        if constexpr (Op == BulkOp::Xor)
+        {
+            return _mm256_xor_si256(lhs, rhs);
+        }
+        else if constexpr (Op == BulkOp::And)
+        {
+            return _mm256_and_si256(lhs, rhs);
+        }
+        else
+        {
+            return _mm256_or_si256(lhs, rhs);
+        }
+    }
+#endif
+
+    template <BulkOp Op>
+    DynamicBitset &apply(const DynamicBitset &other)
+    {
+        if (m_bits != other.m_bits) [[unlikely]]
+        {
+            throwWidthMismatch();
+        }
+        if (isInline())
+        {
+            // Small-buffer case: a single inline word, as cheap as std::bitset<64>.
+            m_words.inlineWord = combine<Op>(m_words.inlineWord, other.m_words.inlineWord);
+            return *this;
+        }
+        Word *dst = data();
+        const Word *src = other.data();
+        const std::size_t words = wordCount();
+        std::size_t i = 0;
+#if defined(__AVX2__)
+        for (; i + 4 <= words; i += 4)
+        {
+            const __m256i lhs = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(dst + i));
+            const __m256i rhs = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i), combine<Op>(lhs, rhs));
+        }
+#endif
+        for (; i < words; ++i)
+        {
+            dst[i] = combine<Op>(dst[i], src[i]);
+        }
+        return *this;
+    }
+
+    std::size_t m_bits = 0;
+    Words m_words;
+};
+
+static_assert(sizeof(DynamicBitset) == sizeof(std::size_t) + sizeof(DynamicBitset::Word));
+
+inline void swap(DynamicBitset &lhs, DynamicBitset &rhs) noexcept
+{
+    lhs.swap(rhs);
+}
+
+} // namespace common
+
+namespace std
+{
+template <>
+struct hash<common::DynamicBitset>
+{
+    std::size_t operator()(const common::DynamicBitset &bits) const noexcept
+    {
+        uint64_t hash = 0x9E3779B97F4A7C15ULL ^ bits.size();
+        const auto *words = bits.data();
+        for (std::size_t i = 0; i < bits.wordCount(); ++i)
+        {
+            hash ^= words[i] + 0x9E3779B97F4A7C15ULL + (hash << 6) + (hash >> 2);
+        }
+        return static_cast<std::size_t>(hash);
+    }
+};
+} // namespace std
@@ -0,0 +1,201 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace common::math
+{
+/// @brief Narrow a 128-bit intermediate back to int64_t, throwing if it does not fit.
+inline int64_t narrowChecked(__int128 value)
+{
+    if (value > std::numeric_limits<int64_t>::max() || value < std::numeric_limits<int64_t>::min())
+    {
+        throw std::overflow_error("int64 overflow in exact arithmetic");
+    }
+    return static_cast<int64_t>(value);
+}
+
+inline int64_t checkedAdd(int64_t lhs, int64_t rhs)
+{
+    return narrowChecked(static_cast<__int128>(lhs) + rhs);
+}
+
+inline int64_t checkedSub(int64_t lhs, int64_t rhs)
+{
+    return narrowChecked(static_cast<__int128>(lhs) - rhs);
+}
+
+inline int64_t checkedMul(int64_t lhs, int64_t rhs)
+{
+    return narrowChecked(static_cast<__int128>(lhs) * rhs);
+}
+
+namespace detail
+{
+inline uint64_t absMagnitude(int64_t value)
+{
+    return value < 0 ? 0 - static_cast<uint64_t>(value) : static_cast<uint64_t>(value);
+}
+
+/// @brief (a * b - c * d) / divisor for an exact division. Stays in 64-bit arithmetic while
+/// nothing overflows and only widens to __int128 (checked) when it does.
+inline int64_t crossQuotient(int64_t a, int64_t b, int64_t c, int64_t d, int64_t divisor)
+{
+    int64_t lhs = 0;
+    int64_t rhs = 0;
+    int64_t cross = 0;
+    if (!__builtin_mul_overflow(a, b, &lhs) && !__builtin_mul_overflow(c, d, &rhs) &&
+        !__builtin_sub_overflow(lhs, rhs, &cross) && divisor != -1) [[likely]]
+    {
+        return divisor == 1 ? cross : cross / divisor;
+    }
+    const __int128 wide = static_cast<__int128>(a) * b - static_cast<__int128>(c) * d;
+    return narrowChecked(wide / divisor);
+}
+} // namespace detail
+
+/// @brief Dense integer matrix stored row-major in one contiguous buffer.
+class IntMatrix
+{
+public:
+    IntMatrix() = default;
+    IntMatrix(std::size_t rows, std::size_t cols, int64_t value = 0)
+        : m_rows(rows), m_cols(cols), m_cells(rows * cols, value)
+    {
+    }
+
+    int64_t &operator()(std::size_t row, std::size_t col) { return m_cells[row * m_cols + col]; }
+    int64_t operator()(std::size_t row, std::size_t col) const { return m_cells[row * m_cols + col]; }
+
+    int64_t *row(std::size_t index) { return m_cells.data() + index * m_cols; }
+    const int64_t *row(std::size_t index) const { return m_cells.data() + index * m_cols; }
+
+    std::size_t rows() const noexcept { return m_rows; }
+    std::size_t cols() const noexcept { return m_cols; }
+
+    void swapRows(std::size_t lhs, std::size_t rhs)
+    {
+        if (lhs != rhs)
+        {
+            std::swap_ranges(row(lhs), row(lhs) + m_cols, row(rhs));
+        }
+    }
+
+private:
+    std::size_t m_rows = 0;
+    std::size_t m_cols = 0;
+    std::vector<int64_t> m_cells;
+};
+
+struct EliminationResult
+{
+    /// @brief Pivot column of each of the first rank rows.
+    std::vector<std::size_t> pivotCols;
+    std::size_t rank = 0;
+};
+
+/// @brief Fraction-free (Bareiss) Gauss-Jordan elimination, in place. Pivots are positive.
+/// Only the first variableCols columns are used for pivots; any columns after them (e.g. an
+/// augmented right-hand side) are carried along. Afterwards row r < rank has a non-zero entry
+/// in pivotCols[r], zeros in every other pivot column, and rows >= rank are zero on the
+/// variable columns. Each step divides exactly by the previous pivot, so entries stay integral
+/// and bounded by minors of the input without any gcd. Every product is overflow-checked
+/// (see detail::crossQuotient), so an out-of-range entry throws std::overflow_error.
+inline EliminationResult bareissReduce(IntMatrix &matrix, std::size_t variableCols)
+{
+    EliminationResult result;
+    const std::size_t rows = matrix.rows();
+    const std::size_t cols = matrix.cols();
+    result.pivotCols.reserve(std::min(rows, variableCols));
+    int64_t previousPivot = 1;
+
+    for (std::size_t col = 0; col < variableCols && result.rank < rows; ++col)
+    {
+        // Prefer the smallest magnitude: on 0/1 systems that is usually a unit pivot, which
+        // keeps entries small and turns the exact division into a no-op.
+        std::size_t found = rows;
+        for (std::size_t r = result.rank; r < rows; ++r)
+        {
+            const int64_t value = matrix(r, col);
+            if (value != 0 && (found == rows || detail::absMagnitude(value) < detail::absMagnitude(matrix(found, col))))
+            {
+                found = r;
+                if (detail::absMagnitude(value) == 1)
+                {
+                    break;
+                }
+            }
+        }
+        if (found == rows)
+        {
+            continue;
+        }
+
+        const std::size_t pivotRow = result.rank;
+        matrix.swapRows(pivotRow, found);
+        if (matrix(pivotRow, col) < 0)
+        {
+            // Negating a not-yet-used row is the same as negating it in the input.
+            for (std::size_t c = 0; c < cols; ++c)
+            {
+                matrix(pivotRow, c) = checkedSub(0, matrix(pivotRow, c));
+            }
+        }
+        const int64_t pivot = matrix(pivotRow, col);
+        const int64_t *pivotData = matrix.row(pivotRow);
+
+        for (std::size_t r = 0; r < rows; ++r)
+        {
+            int64_t *data = matrix.row(r);
+            const int64_t factor = data[col];
+            if (r == pivotRow || (factor == 0 && pivot == previousPivot))
+            {
+                continue; // (pivot * x - 0) / pivot == x
+            }
+            // Rows below the pivot are already zero left of this column.
+            for (std::size_t c = r < pivotRow ? 0 : col; c < cols; ++c)
+            {
+                data[c] = detail::crossQuotient(pivot, data[c], factor, pivotData[c], previousPivot);
+            }
+        }
+
+        result.pivotCols.push_back(col);
+        ++result.rank;
+        previousPivot = pivot;
+    }
+    return result;
+}
+
+/// @brief Divide each of the first rank rows by the gcd of its entries and make the pivot
+/// positive. One gcd pass per row, after elimination, keeps the numbers small.
+inline void normalizeRows(IntMatrix &matrix, const EliminationResult &reduced)
+{
+    for (std::size_t r = 0; r < reduced.rank; ++r)
+    {
+        int64_t *data = matrix.row(r);
+        int64_t divisor = 0;
+        for (std::size_t c = 0; c < matrix.cols() && divisor != 1; ++c)
+        {
+            divisor = std::gcd(divisor, data[c]);
+        }
+        if (data[reduced.pivotCols[r]] < 0)
+        {
+            divisor = -divisor;
+        }
+        if (divisor == 0 || divisor == 1)
+        {
+            continue;
+        }
+        for (std::size_t c = 0; c < matrix.cols(); ++c)
+        {
+            data[c] /= divisor;
+        }
+    }
+}
+
+} // namespace common::math
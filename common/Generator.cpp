@@ -0,0 +1,85 @@
+#include "Generator.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+#include <unordered_set>
+
+namespace common::gen
+{
+std::vector<int64_t> Random::distinct(std::size_t count, int64_t low, int64_t high)
+{
+    const auto span = static_cast<uint64_t>(high - low) + 1;
+    if (high < low || span < count)
+    {
+        throw std::invalid_argument("distinct: interval holds fewer than the requested values");
+    }
+
+    std::vector<int64_t> values;
+    if (span <= 4 * static_cast<uint64_t>(count))
+    {
+        // Dense request: take a prefix of a shuffled interval instead of retrying collisions.
+        values.resize(span);
+        std::iota(values.begin(), values.end(), low);
+        shuffle(values);
+        values.resize(count);
+    }
+    else
+    {
+        std::unordered_set<int64_t> seen;
+        seen.reserve(count);
+        values.reserve(count);
+        while (values.size() < count)
+        {
+            const auto value = between(low, high);
+            if (seen.insert(value).second)
+            {
+                values.push_back(value);
+            }
+        }
+    }
+    std::sort(values.begin(), values.end());
+    return values;
+}
+
+std::size_t scaled(std::size_t base, const Params &params)
+{
+    return base * std::max(params.scale, 1u);
+}
+
+std::size_t scaledSide(std::size_t base, const Params &params)
+{
+    const double factor = std::sqrt(static_cast<double>(std::max(params.scale, 1u)));
+    return static_cast<std::size_t>(std::lround(static_cast<double>(base) * factor));
+}
+
+void writeTo(const Generator &generator, const Params &params, const std::filesystem::path &path)
+{
+    if (path.empty() || path == "-")
+    {
+        generator(std::cout, params);
+        std::cout << std::flush;
+        return;
+    }
+
+    if (path.has_parent_path())
+    {
+        std::filesystem::create_directories(path.parent_path());
+    }
+    std::ofstream file(path, std::ios::binary);
+    if (!file.is_open())
+    {
+        throw std::runtime_error("Could not write generated input to " + path.string());
+    }
+    generator(file, params);
+    file.flush();
+    if (!file)
+    {
+        throw std::runtime_error("Could not write generated input to " + path.string());
+    }
+}
+
+} // namespace common::gen
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <ostream>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace common::gen
+{
+/// @brief Size and seed of a synthetic input. Scale 1 is roughly the size of a real puzzle
+/// input; each day's generator documents what it multiplies.
+struct Params
+{
+    unsigned scale = 1;
+    uint64_t seed = 1;
+};
+
+/**
+ * @brief Seeded random source for the generators.
+ *
+ * Draws are derived from the raw std::mt19937_64 output rather than the standard
+ * distributions, whose algorithms differ between standard libraries, so a seed produces the
+ * same input with every toolchain.
+ */
+class Random
+{
+public:
+    explicit Random(uint64_t seed) : m_engine(seed) {}
+
+    /// @brief Uniform integer in [low, high].
+    int64_t between(int64_t low, int64_t high)
+    {
+        const auto span = static_cast<uint64_t>(high - low) + 1;
+        if (span == 0)
+        {
+            return static_cast<int64_t>(m_engine());
+        }
+        // Multiply-shift maps the 64 random bits onto the span without a modulo bias worth noting.
+        const auto scaled = static_cast<unsigned __int128>(m_engine()) * span;
+        return low + static_cast<int64_t>(static_cast<uint64_t>(scaled >> 64));
+    }
+
+    /// @brief Uniform real in [0, 1).
+    double real() { return static_cast<double>(m_engine() >> 11) * 0x1.0p-53; }
+
+    /// @brief True with probability p.
+    bool chance(double p) { return real() < p; }
+
+    template <typename T>
+    const T &pick(const std::vector<T> &values)
+    {
+        return values[static_cast<std::size_t>(between(0, static_cast<int64_t>(values.size()) - 1))];
+    }
+
+    /// @brief Fisher-Yates shuffle driven by between().
+    template <typename T>
+    void shuffle(std::vector<T> &values)
+    {
+        for (std::size_t i = values.size(); i > 1; --i)
+        {
+            std::swap(values[i - 1], values[static_cast<std::size_t>(between(0, static_cast<int64_t>(i) - 1))]);
+        }
+    }
+
+    /// @brief count distinct integers from [low, high] in ascending order. Throws
+    /// std::invalid_argument when the interval holds fewer than count values.
+    std::vector<int64_t> distinct(std::size_t count, int64_t low, int64_t high);
+
+private:
+    std::mt19937_64 m_engine;
+};
+
+/// @brief base items multiplied by the scale, e.g. lines of a list input.
+std::size_t scaled(std::size_t base, const Params &params);
+
+/// @brief Side of a square grid with scale times the cells of a base x base grid.
+std::size_t scaledSide(std::size_t base, const Params &params);
+
+/// @brief Writes one synthetic input for params to out.
+using Generator = std::function<void(std::ostream &out, const Params &params)>;
+
+/// @brief Runs generator into path, creating parent directories; "-" or empty writes to
+/// stdout. Throws std::runtime_error when the file cannot be written.
+void writeTo(const Generator &generator, const Params &params, const std::filesystem::path &path);
+
+} // namespace common::gen
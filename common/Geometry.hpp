@@ -0,0 +1,516 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "Grid.hpp"
+
+namespace common::geometry
+{
+using Point = common::grid::Coordinate;
+
+/// @brief Number of tiles covered by the axis-aligned rectangle with opposite corners a and b (inclusive).
+inline uint64_t rectangleArea(Point a, Point b)
+{
+    const auto width = static_cast<uint64_t>(std::llabs(a.x - b.x)) + 1;
+    const auto height = static_cast<uint64_t>(std::llabs(a.y - b.y)) + 1;
+    return width * height;
+}
+
+/// @brief Counters describing how much work a rectangle search did.
+struct RectangleSearchStats
+{
+    /// @brief Number of distinct point pairs in the input.
+    uint64_t totalPairs = 0;
+    /// @brief Pairs whose area (and predicate, if any) was actually evaluated.
+    uint64_t evaluated = 0;
+    /// @brief Pairs skipped because their upper bound could not beat the best result.
+    uint64_t pruned = 0;
+};
+
+/// @brief Returns the points lying on the four orthogonal "staircases" of the set.
+/// A point is kept when no other point weakly dominates it towards one of the four
+/// diagonal directions. The largest rectangle spanned by two input points always
+/// has both corners in this set, so it is a safe candidate list for a max-area search.
+inline std::vector<Point> staircaseExtremes(const std::vector<Point> &points)
+{
+    std::vector<Point> extremes;
+    std::vector<Point> sorted(points);
+
+    for (const int64_t sx : {-1, 1})
+    {
+        for (const int64_t sy : {-1, 1})
+        {
+            std::sort(sorted.begin(), sorted.end(), [sx, sy](const Point &lhs, const Point &rhs) {
+                if (lhs.x != rhs.x)
+                {
+                    return sx * lhs.x > sx * rhs.x;
+                }
+                return sy * lhs.y > sy * rhs.y;
+            });
+
+            int64_t bestY = std::numeric_limits<int64_t>::min();
+            for (const auto &point : sorted)
+            {
+                if (sy * point.y > bestY)
+                {
+                    bestY = sy * point.y;
+                    extremes.push_back(point);
+                }
+            }
+        }
+    }
+
+    std::sort(extremes.begin(), extremes.end(), [](const Point &lhs, const Point &rhs) {
+        return lhs.x != rhs.x ? lhs.x < rhs.x : lhs.y < rhs.y;
+    });
+    extremes.erase(std::unique(extremes.begin(), extremes.end()), extremes.end());
+    return extremes;
+}
+
+namespace detail
+{
+struct BoundedPoint
+{
+    Point point;
+    /// Largest area the point can span with any point of the bounding box.
+    uint64_t bound;
+};
+
+/// @brief points paired with their farthest bounding-box corner's area, largest bound
+/// first. A pair's area never exceeds the smaller of its two bounds.
+inline std::vector<BoundedPoint> orderByAreaBound(const std::vector<Point> &points)
+{
+    std::vector<BoundedPoint> ordered;
+    if (points.empty())
+    {
+        return ordered;
+    }
+    int64_t minX = points.front().x;
+    int64_t maxX = minX;
+    int64_t minY = points.front().y;
+    int64_t maxY = minY;
+    for (const auto &point : points)
+    {
+        minX = std::min(minX, point.x);
+        maxX = std::max(maxX, point.x);
+        minY = std::min(minY, point.y);
+        maxY = std::max(maxY, point.y);
+    }
+
+    ordered.reserve(points.size());
+    for (const auto &point : points)
+    {
+        const Point farthest{point.x - minX > maxX - point.x ? minX : maxX,
+                             point.y - minY > maxY - point.y ? minY : maxY};
+        ordered.push_back({point, rectangleArea(point, farthest)});
+    }
+    std::sort(ordered.begin(), ordered.end(), [](const BoundedPoint &lhs, const BoundedPoint &rhs) {
+        return lhs.bound > rhs.bound;
+    });
+    return ordered;
+}
+} // namespace detail
+
+/// @brief Largest rectangle spanned by any two points, found by branch and bound.
+/// Candidates are restricted to the staircase extremes and ordered by an upper bound
+/// on the area they can reach against the bounding box; the search stops as soon as
+/// no remaining pair can beat the best area found so far.
+inline uint64_t largestRectangle(const std::vector<Point> &points, RectangleSearchStats *stats = nullptr)
+{
+    const uint64_t n = points.size();
+    RectangleSearchStats local;
+    local.totalPairs = n < 2 ? 0 : n * (n - 1) / 2;
+
+    const auto candidates = staircaseExtremes(points);
+    // Any pair covers at least one tile, even when duplicates collapse the candidate list.
+    uint64_t best = n < 2 ? 0 : 1;
+    if (!candidates.empty())
+    {
+        const auto ordered = detail::orderByAreaBound(candidates);
+        for (std::size_t i = 0; i < ordered.size() && ordered[i].bound > best; ++i)
+        {
+            // Partners are sorted by bound too, so the first one that cannot win ends the row.
+            for (std::size_t j = i + 1; j < ordered.size() && ordered[j].bound > best; ++j)
+            {
+                ++local.evaluated;
+                best = std::max(best, rectangleArea(ordered[i].point, ordered[j].point));
+            }
+        }
+    }
+
+    local.pruned = local.totalPairs - std::min(local.totalPairs, local.evaluated);
+    if (stats)
+    {
+        *stats = local;
+    }
+    return best;
+}
+
+namespace detail
+{
+/// A run of points that lie close together, with their bounding box.
+struct PointBlock
+{
+    uint32_t begin;
+    uint32_t end;
+    int64_t minX;
+    int64_t maxX;
+    int64_t minY;
+    int64_t maxY;
+};
+
+/// @brief Reorders points into compact blocks of at most blockSize points (sort-tile
+/// packing: vertical strips by x, each strip cut into runs by y) and returns the blocks.
+inline std::vector<PointBlock> packIntoBlocks(std::vector<Point> &points, std::size_t blockSize)
+{
+    std::vector<PointBlock> blocks;
+    const std::size_t n = points.size();
+    if (n == 0)
+    {
+        return blocks;
+    }
+    const std::size_t blockCount = (n + blockSize - 1) / blockSize;
+    const auto strips = static_cast<std::size_t>(std::ceil(std::sqrt(static_cast<double>(blockCount))));
+    const std::size_t stripSize = ((n + strips - 1) / strips + blockSize - 1) / blockSize * blockSize;
+
+    std::sort(points.begin(), points.end(), [](const Point &lhs, const Point &rhs) { return lhs.x < rhs.x; });
+    for (std::size_t strip = 0; strip < n; strip += stripSize)
+    {
+        const std::size_t stripEnd = std::min(n, strip + stripSize);
+        std::sort(points.begin() + static_cast<std::ptrdiff_t>(strip),
+                  points.begin() + static_cast<std::ptrdiff_t>(stripEnd),
+                  [](const Point &lhs, const Point &rhs) { return lhs.y < rhs.y; });
+        for (std::size_t begin = strip; begin < stripEnd; begin += blockSize)
+        {
+            PointBlock block{static_cast<uint32_t>(begin), static_cast<uint32_t>(std::min(stripEnd, begin + blockSize)),
+                             points[begin].x, points[begin].x, points[begin].y, points[begin].y};
+            for (std::size_t k = block.begin; k < block.end; ++k)
+            {
+                block.minX = std::min(block.minX, points[k].x);
+                block.maxX = std::max(block.maxX, points[k].x);
+                block.minY = std::min(block.minY, points[k].y);
+                block.maxY = std::max(block.maxY, points[k].y);
+            }
+            blocks.push_back(block);
+        }
+    }
+    return blocks;
+}
+} // namespace detail
+
+/// @brief Largest rectangle spanned by two points that also satisfies accept(a, b).
+/// Pairs are tested in descending area order, so the first accepted pair is optimal and
+/// every smaller pair is pruned without calling the (expensive) predicate. The order is
+/// produced in batches of the next-largest pairs. Batches start at a few pairs per point
+/// and double while no pair is accepted, up to a fixed cap, so memory stays bounded.
+///
+/// Points are packed into small compact blocks, and each pair of blocks carries the
+/// smallest and largest area its boxes allow. A batch only scans the block pairs whose
+/// range overlaps the band between the batch's floor and the previous batch's ceiling.
+/// Block pairs lying wholly above a ceiling are dropped for good, so later batches do not
+/// rescan the pairs that earlier ones already handed out.
+template <typename Accept>
+std::optional<uint64_t> largestRectangleWhere(const std::vector<Point> &input,
+                                              Accept &&accept,
+                                              RectangleSearchStats *stats = nullptr)
+{
+    /// Ties on area are broken by position so every pair has a distinct rank.
+    struct Candidate
+    {
+        uint64_t area;
+        uint32_t first;
+        uint32_t second;
+        auto operator<=>(const Candidate &) const = default;
+    };
+    struct BlockPair
+    {
+        uint64_t maxArea;
+        uint64_t minArea;
+        uint32_t first;
+        uint32_t second;
+    };
+    constexpr std::size_t kMinBatch = 4096;
+    constexpr std::size_t kMaxBatch = std::size_t{1} << 21;
+    // Small blocks bound tightly; the cap on their count keeps the block pairs in memory small.
+    constexpr std::size_t kMinBlockSize = 32;
+    constexpr std::size_t kMaxBlocks = 1024;
+
+    const uint64_t n = input.size();
+    RectangleSearchStats local;
+    local.totalPairs = n < 2 ? 0 : n * (n - 1) / 2;
+
+    std::vector<Point> points(input);
+    const auto blocks = detail::packIntoBlocks(points, std::max(kMinBlockSize, (points.size() + kMaxBlocks - 1) / kMaxBlocks));
+    std::vector<BlockPair> blockPairs;
+    for (uint32_t a = 0; a < blocks.size(); ++a)
+    {
+        for (uint32_t b = a; b < blocks.size(); ++b)
+        {
+            const auto &lhs = blocks[a];
+            const auto &rhs = blocks[b];
+            if (a == b && lhs.end - lhs.begin < 2)
+            {
+                continue;
+            }
+            const Point gap{std::max<int64_t>({0, rhs.minX - lhs.maxX, lhs.minX - rhs.maxX}),
+                            std::max<int64_t>({0, rhs.minY - lhs.maxY, lhs.minY - rhs.maxY})};
+            blockPairs.push_back({rectangleArea({std::min(lhs.minX, rhs.minX), std::min(lhs.minY, rhs.minY)},
+                                                {std::max(lhs.maxX, rhs.maxX), std::max(lhs.maxY, rhs.maxY)}),
+                                  rectangleArea({0, 0}, gap), a, b});
+        }
+    }
+    std::sort(blockPairs.begin(), blockPairs.end(),
+              [](const BlockPair &lhs, const BlockPair &rhs) { return lhs.maxArea > rhs.maxArea; });
+
+    std::size_t capacity = std::clamp<std::size_t>(4 * points.size(), kMinBatch, kMaxBatch);
+    const auto byRankDescending = std::greater<Candidate>();
+    std::vector<Candidate> batch;
+    std::optional<Candidate> ceiling;
+    std::optional<uint64_t> result;
+    while (!result)
+    {
+        // Collects the `capacity` highest-ranked pairs below the previous batch. Whenever the
+        // buffer doubles, it is cut back to its best half and the cut raises the area floor.
+        batch.clear();
+        uint64_t floor = 0;
+        const auto keepBest = [&] {
+            std::nth_element(batch.begin(), batch.begin() + static_cast<std::ptrdiff_t>(capacity - 1), batch.end(),
+                             byRankDescending);
+            batch.resize(capacity);
+            floor = batch.back().area;
+        };
+        const auto offer = [&](uint32_t i, uint32_t j) {
+            const Candidate candidate{rectangleArea(points[i], points[j]), i, j};
+            if (candidate.area < floor || (ceiling && !(candidate < *ceiling)))
+            {
+                return;
+            }
+            batch.push_back(candidate);
+            if (batch.size() == 2 * capacity)
+            {
+                keepBest();
+            }
+        };
+        for (std::size_t k = 0; k < blockPairs.size() && blockPairs[k].maxArea >= floor; ++k)
+        {
+            const auto &lhs = blocks[blockPairs[k].first];
+            const auto &rhs = blocks[blockPairs[k].second];
+            for (uint32_t i = lhs.begin; i < lhs.end; ++i)
+            {
+                for (uint32_t j = blockPairs[k].first == blockPairs[k].second ? i + 1 : rhs.begin; j < rhs.end; ++j)
+                {
+                    offer(i, j);
+                }
+            }
+        }
+        if (batch.empty())
+        {
+            break;
+        }
+        if (batch.size() > capacity)
+        {
+            keepBest();
+        }
+
+        std::sort(batch.begin(), batch.end(), byRankDescending);
+        for (const auto &candidate : batch)
+        {
+            ++local.evaluated;
+            if (accept(points[candidate.first], points[candidate.second]))
+            {
+                result = candidate.area;
+                break;
+            }
+        }
+        ceiling = batch.back();
+        std::erase_if(blockPairs, [&](const BlockPair &pair) { return pair.minArea > ceiling->area; });
+        capacity = std::min(2 * capacity, kMaxBatch);
+    }
+
+    local.pruned = local.totalPairs - local.evaluated;
+    if (stats)
+    {
+        *stats = local;
+    }
+    return result;
+}
+
+/// @brief Static index over axis-aligned segments that share one orientation.
+/// Segments are keyed on their fixed coordinate (x for vertical edges, y for horizontal
+/// ones) and laid out as a merge-sort tree: level L holds blocks of 2^L key-adjacent
+/// segments sorted by the low end of their span, with a running maximum of the high end.
+/// "Is any segment strictly inside this key range and overlapping this open span" then
+/// costs O(log^2 n) with no allocation, instead of a scan over every segment.
+class SegmentIndex
+{
+public:
+    struct Segment
+    {
+        int64_t key = 0;
+        int64_t lo = 0;
+        int64_t hi = 0;
+    };
+
+    SegmentIndex() = default;
+
+    explicit SegmentIndex(std::vector<Segment> segments)
+    {
+        for (auto &segment : segments)
+        {
+            if (segment.lo > segment.hi)
+            {
+                std::swap(segment.lo, segment.hi);
+            }
+        }
+        std::sort(segments.begin(), segments.end(), [](const Segment &lhs, const Segment &rhs) {
+            return lhs.key < rhs.key;
+        });
+
+        const std::size_t n = segments.size();
+        m_keys.reserve(n);
+        std::vector<Segment> current(segments);
+        for (const auto &segment : segments)
+        {
+            m_keys.push_back(segment.key);
+        }
+
+        std::vector<Segment> merged(n);
+        for (std::size_t width = 1; n > 0; width <<= 1)
+        {
+            Level level;
+            level.lo.resize(n);
+            level.maxHi.resize(n);
+            for (std::size_t start = 0; start < n; start += width)
+            {
+                const std::size_t end = std::min(start + width, n);
+                int64_t runningMax = std::numeric_limits<int64_t>::min();
+                for (std::size_t i = start; i < end; ++i)
+                {
+                    runningMax = std::max(runningMax, current[i].hi);
+                    level.lo[i] = current[i].lo;
+                    level.maxHi[i] = runningMax;
+                }
+            }
+            m_levels.push_back(std::move(level));
+            if (width >= n)
+            {
+                break;
+            }
+
+            // Merge neighbouring blocks by span start to form the next level.
+            for (std::size_t start = 0; start < n; start += 2 * width)
+            {
+                const auto first = current.begin() + static_cast<std::ptrdiff_t>(start);
+                const auto middle = current.begin() + static_cast<std::ptrdiff_t>(std::min(start + width, n));
+                const auto last = current.begin() + static_cast<std::ptrdiff_t>(std::min(start + 2 * width, n));
+                std::merge(first, middle, middle, last, merged.begin() + static_cast<std::ptrdiff_t>(start),
+                           [](const Segment &lhs, const Segment &rhs) { return lhs.lo < rhs.lo; });
+            }
+            current.swap(merged);
+        }
+    }
+
+    std::size_t size() const noexcept { return m_keys.size(); }
+
+    /// @brief True if a segment has keyMin < key < keyMax and lo < spanMax && hi > spanMin.
+    bool anyCrossing(int64_t keyMin, int64_t keyMax, int64_t spanMin, int64_t spanMax) const
+    {
+        auto a = static_cast<std::size_t>(std::upper_bound(m_keys.begin(), m_keys.end(), keyMin) - m_keys.begin());
+        auto b = static_cast<std::size_t>(std::lower_bound(m_keys.begin(), m_keys.end(), keyMax) - m_keys.begin());
+
+        // Decompose [a, b) into aligned power-of-two blocks, one level at a time.
+        for (std::size_t level = 0; a < b; ++level)
+        {
+            const std::size_t width = std::size_t{1} << level;
+            if (a & width)
+            {
+                if (blockCrosses(level, a, a + width, spanMin, spanMax))
+                {
+                    return true;
+                }
+                a += width;
+            }
+            if (a < b && (b & width))
+            {
+                b -= width;
+                if (blockCrosses(level, b, b + width, spanMin, spanMax))
+                {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
+private:
+    struct Level
+    {
+        std::vector<int64_t> lo;
+        std::vector<int64_t> maxHi;
+    };
+
+    bool blockCrosses(std::size_t level, std::size_t start, std::size_t end, int64_t spanMin, int64_t spanMax) const
+    {
+        const auto &data = m_levels[level];
+        const auto first = data.lo.begin() + static_cast<std::ptrdiff_t>(start);
+        const auto last = data.lo.begin() + static_cast<std::ptrdiff_t>(end);
+        const auto count = std::lower_bound(first, last, spanMax) - first;
+        return count > 0 && data.maxHi[start + static_cast<std::size_t>(count) - 1] > spanMin;
+    }
+
+    std::vector<int64_t> m_keys;
+    std::vector<Level> m_levels;
+};
+
+/// @brief Edge index for a closed rectilinear polygon.
+/// Vertical and horizontal edges live in separate SegmentIndex structures keyed on x and y.
+class EdgeIndex
+{
+public:
+    EdgeIndex() = default;
+
+    /// @param polygon Polygon vertices in order; the last vertex connects back to the first.
+    explicit EdgeIndex(const std::vector<Point> &polygon)
+    {
+        std::vector<SegmentIndex::Segment> vertical;
+        std::vector<SegmentIndex::Segment> horizontal;
+        for (std::size_t i = 0; i < polygon.size(); ++i)
+        {
+            const auto &start = polygon[i];
+            const auto &end = polygon[(i + 1) % polygon.size()];
+            if (start.x == end.x)
+            {
+                vertical.push_back({start.x, start.y, end.y});
+            }
+            else
+            {
+                horizontal.push_back({start.y, start.x, end.x});
+            }
+        }
+        m_vertical = SegmentIndex(std::move(vertical));
+        m_horizontal = SegmentIndex(std::move(horizontal));
+    }
+
+    /// @brief True if any edge passes through the interior of the rectangle
+    /// (touching its boundary does not count).
+    bool crossesOpenRectangle(int64_t minX, int64_t maxX, int64_t minY, int64_t maxY) const
+    {
+        return m_vertical.anyCrossing(minX, maxX, minY, maxY) ||
+               m_horizontal.anyCrossing(minY, maxY, minX, maxX);
+    }
+
+private:
+    SegmentIndex m_vertical;
+    SegmentIndex m_horizontal;
+};
+
+} // namespace common::geometry
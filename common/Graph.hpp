@@ -0,0 +1,257 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <optional>
+#include <stdexcept>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "StringUtils.hpp"
+
+namespace common::graph
+{
+using NodeId = uint32_t;
+
+/// @brief Maps node names to dense ids in first-seen order, so per-node data can live in
+/// flat arrays instead of string-keyed maps.
+class NameInterner
+{
+public:
+    /// @brief Id of name, assigning the next free id the first time it is seen.
+    NodeId intern(std::string_view name)
+    {
+        if (const auto it = m_ids.find(name); it != m_ids.end())
+        {
+            return it->second;
+        }
+        const auto id = static_cast<NodeId>(m_names.size());
+        m_names.emplace_back(name);
+        m_ids.emplace(m_names.back(), id);
+        return id;
+    }
+
+    std::optional<NodeId> find(std::string_view name) const
+    {
+        if (const auto it = m_ids.find(name); it != m_ids.end())
+        {
+            return it->second;
+        }
+        return std::nullopt;
+    }
+
+    void reserve(std::size_t count)
+    {
+        m_names.reserve(count);
+        m_ids.reserve(count);
+    }
+
+    const std::string &name(NodeId id) const { return m_names[id]; }
+    std::size_t size() const noexcept { return m_names.size(); }
+
+private:
+    struct TransparentHash
+    {
+        using is_transparent = void;
+        std::size_t operator()(std::string_view text) const noexcept { return std::hash<std::string_view>{}(text); }
+    };
+
+    std::vector<std::string> m_names;
+    std::unordered_map<std::string, NodeId, TransparentHash, std::equal_to<>> m_ids;
+};
+
+/// @brief Immutable directed graph in compressed sparse row form: the successors of node n
+/// are targets[offsets[n] .. offsets[n + 1]), in the order the edges were added.
+class CsrGraph
+{
+public:
+    using Edge = std::pair<NodeId, NodeId>;
+
+    CsrGraph() = default;
+
+    CsrGraph(std::size_t nodeCount, const std::vector<Edge> &edges) : m_offsets(nodeCount + 1, 0)
+    {
+        // Counting sort by source keeps each node's successors in insertion order.
+        for (const auto &[from, to] : edges)
+        {
+            ++m_offsets[from + 1];
+        }
+        for (std::size_t n = 0; n < nodeCount; ++n)
+        {
+            m_offsets[n + 1] += m_offsets[n];
+        }
+        m_targets.resize(edges.size());
+        std::vector<uint32_t> cursor(m_offsets.begin(), m_offsets.end() - 1);
+        for (const auto &[from, to] : edges)
+        {
+            m_targets[cursor[from]++] = to;
+        }
+    }
+
+    std::size_t nodeCount() const noexcept { return m_offsets.empty() ? 0 : m_offsets.size() - 1; }
+    std::size_t edgeCount() const noexcept { return m_targets.size(); }
+
+    std::span<const NodeId> successors(NodeId node) const
+    {
+        return {m_targets.data() + m_offsets[node], m_targets.data() + m_offsets[node + 1]};
+    }
+
+private:
+    std::vector<uint32_t> m_offsets;
+    std::vector<NodeId> m_targets;
+};
+
+/// @brief Nodes reachable from source, in topological order (source first).
+/// Edges back into source are ignored, so "never return to the start" inputs still count as
+/// acyclic. Runs Kahn's algorithm over the reachable subgraph only, iteratively in O(V + E);
+/// throws std::runtime_error if that subgraph contains a cycle.
+inline std::vector<NodeId> reachableTopologicalOrder(const CsrGraph &graph, NodeId source)
+{
+    const std::size_t nodes = graph.nodeCount();
+    std::vector<uint8_t> reachable(nodes, 0);
+    std::vector<uint32_t> inDegree(nodes, 0);
+    std::vector<NodeId> stack{source};
+    reachable[source] = 1;
+    std::size_t reachableCount = 1;
+    while (!stack.empty())
+    {
+        const NodeId node = stack.back();
+        stack.pop_back();
+        for (const NodeId next : graph.successors(node))
+        {
+            if (next == source)
+            {
+                continue;
+            }
+            ++inDegree[next];
+            if (!reachable[next])
+            {
+                reachable[next] = 1;
+                ++reachableCount;
+                stack.push_back(next);
+            }
+        }
+    }
+
+    std::vector<NodeId> order;
+    order.reserve(reachableCount);
+    order.push_back(source);
+    for (std::size_t head = 0; head < order.size(); ++head)
+    {
+        for (const NodeId next : graph.successors(order[head]))
+        {
+            if (next != source && --inDegree[next] == 0)
+            {
+                order.push_back(next);
+            }
+        }
+    }
+    if (order.size() != reachableCount)
+    {
+        throw std::runtime_error("reachableTopologicalOrder: graph has a cycle reachable from the source");
+    }
+    return order;
+}
+
+/// @brief Number of source -> target paths that visit every waypoint, on a DAG.
+/// Counts are pushed forward in topological order with one slot per (node, visited-waypoint
+/// mask), so the cost is O((V + E) * 2^waypoints) with no recursion. Edges back into source
+/// are ignored. Throws std::runtime_error on a reachable cycle, std::invalid_argument for
+/// more than 16 waypoints and std::overflow_error if a count exceeds 64 bits.
+inline uint64_t countPaths(const CsrGraph &graph, NodeId source, NodeId target, std::span<const NodeId> waypoints = {})
+{
+    if (waypoints.size() > 16)
+    {
+        throw std::invalid_argument("countPaths: at most 16 waypoints are supported");
+    }
+    const std::size_t states = std::size_t{1} << waypoints.size();
+    const uint32_t fullMask = static_cast<uint32_t>(states - 1);
+
+    std::vector<uint32_t> waypointBits(graph.nodeCount(), 0);
+    for (std::size_t i = 0; i < waypoints.size(); ++i)
+    {
+        waypointBits[waypoints[i]] |= uint32_t{1} << i;
+    }
+
+    const auto order = reachableTopologicalOrder(graph, source);
+    std::vector<uint64_t> counts(graph.nodeCount() * states, 0);
+    counts[std::size_t{source} * states + waypointBits[source]] = 1;
+    for (const NodeId node : order)
+    {
+        if (node == target)
+        {
+            continue; // Paths end here.
+        }
+        const uint64_t *from = counts.data() + std::size_t{node} * states;
+        for (const NodeId next : graph.successors(node))
+        {
+            if (next == source)
+            {
+                continue;
+            }
+            uint64_t *to = counts.data() + std::size_t{next} * states;
+            for (uint32_t mask = 0; mask <= fullMask; ++mask)
+            {
+                if (from[mask] != 0 && __builtin_add_overflow(to[mask | waypointBits[next]], from[mask],
+                                                              &to[mask | waypointBits[next]]))
+                {
+                    throw std::overflow_error("countPaths: path count exceeds 64 bits");
+                }
+            }
+        }
+    }
+    return counts[std::size_t{target} * states + fullMask];
+}
+
+/// @brief A CSR graph together with the names of its nodes.
+struct NamedGraph
+{
+    NameInterner names;
+    CsrGraph graph;
+};
+
+/// @brief Parses lines of the form "name: succ succ ..." into a NamedGraph.
+/// Nodes that only appear as successors get ids too (and no outgoing edges).
+inline NamedGraph parseAdjacencyLines(const std::vector<std::string> &lines, char separator = ':')
+{
+    NamedGraph result;
+    // Every line names one node; most successors are other lines' nodes.
+    result.names.reserve(lines.size() + 1);
+    std::vector<CsrGraph::Edge> edges;
+    edges.reserve(lines.size());
+    for (const auto &line : lines)
+    {
+        const std::string_view view(line);
+        const auto colon = view.find(separator);
+        if (colon == std::string_view::npos)
+        {
+            continue;
+        }
+        const NodeId from = result.names.intern(str::trim_view(view.substr(0, colon)));
+
+        std::string_view rest = view.substr(colon + 1);
+        while (!rest.empty())
+        {
+            const auto space = rest.find(' ');
+            const auto token = rest.substr(0, space);
+            if (!token.empty())
+            {
+                edges.emplace_back(from, result.names.intern(token));
+            }
+            if (space == std::string_view::npos)
+            {
+                break;
+            }
+            rest.remove_prefix(space + 1);
+        }
+    }
+    result.graph = CsrGraph(result.names.size(), edges);
+    return result;
+}
+
+} // namespace common::graph
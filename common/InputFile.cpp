@@ -37,28 +37,26 @@ const std::vector<std::string> &InputFile::getLines() const
 
 const std::string &InputFile::getText() const
 {
-    if (!_text.has_value())
-    {
-        _text.emplace();
-        _text->reserve(_lines.size() * 8);
+    return _text.get([this] {
+        std::string text;
+        text.reserve(_lines.size() * 8);
         for (std::size_t i = 0; i < _lines.size(); ++i)
         {
-            *_text += _lines[i];
+            text += _lines[i];
             if (i + 1 < _lines.size())
             {
-                _text->push_back('\n');
+                text.push_back('\n');
             }
         }
-    }
-    return *_text;
+        return text;
+    });
 }
 
 const std::vector<int64_t> &InputFile::asIntegers() const
 {
-    if (!_integers.has_value())
-    {
-        _integers.emplace();
-        _integers->reserve(_lines.size());
+    return _integers.get([this] {
+        std::vector<int64_t> integers;
+        integers.reserve(_lines.size());
         for (const auto &line : _lines)
         {
             if (line.empty())
@@ -74,31 +72,46 @@ const std::vector<int64_t> &InputFile::asIntegers() const
             {
                 throw std::runtime_error("Failed to parse integer from input line: " + line);
             }
-            _integers->push_back(value);
+            integers.push_back(value);
         }
-    }
-    return *_integers;
+        return integers;
+    });
 }
 
 const common::grid::Grid<char> &InputFile::asGrid() const
 {
-    if (!_grid.has_value())
-    {
+    return _grid.get([this] {
         std::size_t height = _lines.size();
         std::size_t width = height > 0 ? _lines[0].size() : 0;
-        _grid.emplace(width, height);
+        common::grid::Grid<char> grid(width, height);
         for (std::size_t y = 0; y < height; ++y)
         {
             for (std::size_t x = 0; x < _lines[y].size(); ++x)
             {
-                (*_grid)(x, y) = _lines[y][x];
+                grid(x, y) = _lines[y][x];
             }
         }
-    }
-    return *_grid;
+        return grid;
+    });
 }
 
 InputFile InputFile::fromLines(std::vector<std::string> lines, std::string filename)
 {
     return InputFile(std::move(filename), std::move(lines));
+}
+
+InputFile InputFile::fromText(std::string_view text, std::string filename)
+{
+    std::vector<std::string> lines;
+    while (!text.empty())
+    {
+        const auto newline = text.find('\n');
+        lines.emplace_back(text.substr(0, newline));
+        if (newline == std::string_view::npos)
+        {
+            break;
+        }
+        text.remove_prefix(newline + 1);
+    }
+    return InputFile(std::move(filename), std::move(lines));
 }
\ No newline at end of file
@@ -3,6 +3,8 @@
 #include <cstdint>
 #include <fstream>
 #include <iostream>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <string>
 #include <string_view>
@@ -11,6 +13,46 @@
 
 #include "Grid.hpp"
 
+namespace common::detail
+{
+/// @brief A value computed on first use, at most once even when several threads ask for it
+/// together. Copies and moves start empty and recompute on demand. A std::once_flag can be
+/// neither copied nor moved, so each of them allocates a fresh one and is not noexcept.
+template <typename T>
+class OnceValue
+{
+public:
+    OnceValue() = default;
+    OnceValue(const OnceValue &) {}
+    OnceValue(OnceValue &&) {}
+    OnceValue &operator=(const OnceValue &)
+    {
+        m_state = std::make_unique<State>();
+        return *this;
+    }
+    OnceValue &operator=(OnceValue &&)
+    {
+        m_state = std::make_unique<State>();
+        return *this;
+    }
+
+    template <typename Compute>
+    const T &get(Compute &&compute) const
+    {
+        std::call_once(m_state->flag, [&] { m_state->value.emplace(compute()); });
+        return *m_state->value;
+    }
+
+private:
+    struct State
+    {
+        std::once_flag flag;
+        std::optional<T> value;
+    };
+    std::unique_ptr<State> m_state = std::make_unique<State>();
+};
+} // namespace common::detail
+
 class InputFile
 {
 public:
@@ -47,6 +89,7 @@ public:
 
     /**
      * @brief Returns parsed integers (cache is reused across calls)
+     * The cached views below are built once and are safe to request from several threads.
      */
     const std::vector<int64_t> &asIntegers() const;
 
@@ -61,15 +104,21 @@ public:
     static InputFile fromLines(std::vector<std::string> lines,
                                std::string filename = "<memory>");
 
+    /**
+     * @brief Splits text into lines the same way the file constructor does (a trailing
+     * newline does not start an extra empty line).
+     */
+    static InputFile fromText(std::string_view text, std::string filename = "<memory>");
+
 private:
     /// @brief Filename to read
     std::string _filename;
     /// @brief Vector of lines from the file
     std::vector<std::string> _lines;
     /// @brief Cached blob of the entire file
-    mutable std::optional<std::string> _text;
+    common::detail::OnceValue<std::string> _text;
     /// @brief Cached integer representation of every non-empty line
-    mutable std::optional<std::vector<int64_t>> _integers;
+    common::detail::OnceValue<std::vector<int64_t>> _integers;
     /// @brief Cached grid representation
-    mutable std::optional<common::grid::Grid<char>> _grid;
+    common::detail::OnceValue<common::grid::Grid<char>> _grid;
 };
\ No newline at end of file
@@ -0,0 +1,233 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace common::math
+{
+/// @brief Outcome of LinearProgram::maximize.
+struct LinearProgramResult
+{
+    enum class Status
+    {
+        Optimal,
+        Infeasible,
+        Unbounded
+    };
+
+    Status status = Status::Infeasible;
+    /// Objective value at the optimum (only meaningful when status is Optimal).
+    double value = 0.0;
+    /// An optimal point (only meaningful when status is Optimal).
+    std::vector<double> point;
+};
+
+/**
+ * @brief Dense two-phase simplex for maximize c.x subject to A x <= b, x >= 0.
+ *
+ * Meant for the small relaxations solved at every node of a branch-and-bound search (a few
+ * variables, a few dozen constraints), not for large sparse problems. Negative entries of b
+ * are handled by a first phase that finds a feasible basis. Bland's rule breaks ties, so
+ * degenerate pivots cannot cycle. Results are in double precision: callers that prune on the
+ * value should allow for rounding.
+ */
+class LinearProgram
+{
+public:
+    static LinearProgramResult maximize(const std::vector<std::vector<double>> &a,
+                                        const std::vector<double> &b,
+                                        const std::vector<double> &c)
+    {
+        LinearProgram program(a, b, c);
+        return program.solve();
+    }
+
+private:
+    static constexpr double kEpsilon = 1e-9;
+
+    LinearProgram(const std::vector<std::vector<double>> &a,
+                  const std::vector<double> &b,
+                  const std::vector<double> &c)
+        : m_rows(b.size()), m_cols(c.size()), m_basic(m_rows), m_nonBasic(m_cols + 1),
+          m_tableau(m_rows + 2, std::vector<double>(m_cols + 2, 0.0))
+    {
+        // Column m_cols is the phase-one auxiliary variable, column m_cols + 1 the right-hand side.
+        for (std::size_t i = 0; i < m_rows; ++i)
+        {
+            for (std::size_t j = 0; j < m_cols; ++j)
+            {
+                m_tableau[i][j] = a[i][j];
+            }
+            m_basic[i] = static_cast<long>(m_cols + i);
+            m_tableau[i][m_cols] = -1.0;
+            m_tableau[i][m_cols + 1] = b[i];
+        }
+        for (std::size_t j = 0; j < m_cols; ++j)
+        {
+            m_nonBasic[j] = static_cast<long>(j);
+            m_tableau[m_rows][j] = -c[j];
+        }
+        m_nonBasic[m_cols] = -1;
+        m_tableau[m_rows + 1][m_cols] = 1.0;
+    }
+
+    LinearProgramResult solve()
+    {
+        LinearProgramResult result;
+        std::size_t lowest = 0;
+        for (std::size_t i = 1; i < m_rows; ++i)
+        {
+            if (m_tableau[i][m_cols + 1] < m_tableau[lowest][m_cols + 1])
+            {
+                lowest = i;
+            }
+        }
+        if (m_rows > 0 && m_tableau[lowest][m_cols + 1] < -kEpsilon)
+        {
+            // Phase one: bring the auxiliary variable in and drive it back to zero.
+            pivot(lowest, m_cols);
+            if (!runSimplex(2) || m_tableau[m_rows + 1][m_cols + 1] < -kEpsilon)
+            {
+                return result;
+            }
+            for (std::size_t i = 0; i < m_rows; ++i)
+            {
+                if (m_basic[i] == -1)
+                {
+                    std::size_t entering = 0;
+                    for (std::size_t j = 1; j <= m_cols; ++j)
+                    {
+                        if (isBetter(m_tableau[i], j, entering))
+                        {
+                            entering = j;
+                        }
+                    }
+                    pivot(i, entering);
+                }
+            }
+        }
+
+        if (!runSimplex(1))
+        {
+            result.status = LinearProgramResult::Status::Unbounded;
+            result.value = std::numeric_limits<double>::infinity();
+            return result;
+        }
+        result.status = LinearProgramResult::Status::Optimal;
+        result.value = m_tableau[m_rows][m_cols + 1];
+        result.point.assign(m_cols, 0.0);
+        for (std::size_t i = 0; i < m_rows; ++i)
+        {
+            if (m_basic[i] >= 0 && static_cast<std::size_t>(m_basic[i]) < m_cols)
+            {
+                result.point[static_cast<std::size_t>(m_basic[i])] = m_tableau[i][m_cols + 1];
+            }
+        }
+        return result;
+    }
+
+    /// Bland's rule: the smaller coefficient, ties broken by the smaller variable index.
+    bool isBetter(const std::vector<double> &row, std::size_t candidate, std::size_t current) const
+    {
+        return std::pair(row[candidate], m_nonBasic[candidate]) < std::pair(row[current], m_nonBasic[current]);
+    }
+
+    void pivot(std::size_t row, std::size_t col)
+    {
+        const double inverse = 1.0 / m_tableau[row][col];
+        const auto &pivotRow = m_tableau[row];
+        for (std::size_t i = 0; i < m_rows + 2; ++i)
+        {
+            if (i == row || std::abs(m_tableau[i][col]) <= kEpsilon)
+            {
+                continue;
+            }
+            auto &target = m_tableau[i];
+            const double factor = target[col] * inverse;
+            for (std::size_t j = 0; j < m_cols + 2; ++j)
+            {
+                target[j] -= pivotRow[j] * factor;
+            }
+            target[col] = pivotRow[col] * factor;
+        }
+        for (std::size_t j = 0; j < m_cols + 2; ++j)
+        {
+            if (j != col)
+            {
+                m_tableau[row][j] *= inverse;
+            }
+        }
+        for (std::size_t i = 0; i < m_rows + 2; ++i)
+        {
+            if (i != row)
+            {
+                m_tableau[i][col] *= -inverse;
+            }
+        }
+        m_tableau[row][col] = inverse;
+        std::swap(m_basic[row], m_nonBasic[col]);
+    }
+
+    /// Pivots until the objective row of the phase is optimal; false if it is unbounded.
+    bool runSimplex(int phase)
+    {
+        const std::size_t objective = phase == 1 ? m_rows : m_rows + 1;
+        for (;;)
+        {
+            std::size_t entering = m_cols + 1;
+            for (std::size_t j = 0; j <= m_cols; ++j)
+            {
+                if (m_nonBasic[j] == -phase)
+                {
+                    continue;
+                }
+                if (entering > m_cols || isBetter(m_tableau[objective], j, entering))
+                {
+                    entering = j;
+                }
+            }
+            if (m_tableau[objective][entering] >= -kEpsilon)
+            {
+                return true;
+            }
+
+            std::size_t leaving = m_rows;
+            for (std::size_t i = 0; i < m_rows; ++i)
+            {
+                if (m_tableau[i][entering] <= kEpsilon)
+                {
+                    continue;
+                }
+                if (leaving == m_rows)
+                {
+                    leaving = i;
+                    continue;
+                }
+                const double ratio = m_tableau[i][m_cols + 1] / m_tableau[i][entering];
+                const double best = m_tableau[leaving][m_cols + 1] / m_tableau[leaving][entering];
+                if (std::pair(ratio, m_basic[i]) < std::pair(best, m_basic[leaving]))
+                {
+                    leaving = i;
+                }
+            }
+            if (leaving == m_rows)
+            {
+                return false;
+            }
+            pivot(leaving, entering);
+        }
+    }
+
+    std::size_t m_rows;
+    std::size_t m_cols;
+    /// Variable index of each row's basic variable (-1 for the auxiliary variable).
+    std::vector<long> m_basic;
+    /// Variable index of each non-basic column.
+    std::vector<long> m_nonBasic;
+    std::vector<std::vector<double>> m_tableau;
+};
+
+} // namespace common::math
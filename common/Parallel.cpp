@@ -0,0 +1,177 @@
+#include "Parallel.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+
+namespace common::parallel
+{
+namespace
+{
+std::atomic<unsigned> g_threadCount{0};
+
+/// Shared between the caller and the helper tasks of one parallelFor. Helpers hold it by
+/// shared_ptr because they may only get scheduled after the caller has already returned.
+struct ForState
+{
+    std::size_t count = 0;
+    std::size_t chunk = 1;
+    std::function<void(std::size_t)> body;
+    std::atomic<std::size_t> next{0};
+    std::atomic<std::size_t> finished{0};
+    std::atomic<bool> failed{false};
+    std::exception_ptr error;
+    std::mutex mutex;
+    std::condition_variable done;
+};
+
+void runChunks(ForState &state)
+{
+    while (true)
+    {
+        const std::size_t start = state.next.fetch_add(state.chunk);
+        if (start >= state.count)
+        {
+            return;
+        }
+        const std::size_t end = std::min(start + state.chunk, state.count);
+        if (!state.failed.load(std::memory_order_relaxed))
+        {
+            try
+            {
+                for (std::size_t i = start; i < end; ++i)
+                {
+                    state.body(i);
+                }
+            }
+            catch (...)
+            {
+                std::lock_guard lock(state.mutex);
+                if (!state.error)
+                {
+                    state.error = std::current_exception();
+                }
+                state.failed = true;
+            }
+        }
+        if (state.finished.fetch_add(end - start) + (end - start) == state.count)
+        {
+            std::lock_guard lock(state.mutex);
+            state.done.notify_all();
+        }
+    }
+}
+} // namespace
+
+void setThreadCount(unsigned count)
+{
+    g_threadCount = count;
+}
+
+unsigned threadCount()
+{
+    const unsigned requested = g_threadCount.load();
+    if (requested != 0)
+    {
+        return requested;
+    }
+    return std::max(1U, std::thread::hardware_concurrency());
+}
+
+ThreadPool::ThreadPool(unsigned workers)
+{
+    m_workers.reserve(workers);
+    for (unsigned i = 0; i < workers; ++i)
+    {
+        m_workers.emplace_back([this] { workerLoop(); });
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard lock(m_mutex);
+        m_stopping = true;
+    }
+    m_ready.notify_all();
+    for (auto &worker : m_workers)
+    {
+        worker.join();
+    }
+}
+
+void ThreadPool::submit(std::function<void()> task)
+{
+    {
+        std::lock_guard lock(m_mutex);
+        m_tasks.push_back(std::move(task));
+    }
+    m_ready.notify_one();
+}
+
+void ThreadPool::workerLoop()
+{
+    while (true)
+    {
+        std::function<void()> task;
+        {
+            std::unique_lock lock(m_mutex);
+            m_ready.wait(lock, [this] { return m_stopping || !m_tasks.empty(); });
+            if (m_tasks.empty())
+            {
+                return;
+            }
+            task = std::move(m_tasks.front());
+            m_tasks.pop_front();
+        }
+        task();
+    }
+}
+
+ThreadPool &sharedPool()
+{
+    static ThreadPool pool(threadCount() - 1);
+    return pool;
+}
+
+void parallelFor(std::size_t count, const std::function<void(std::size_t)> &body)
+{
+    if (count == 0)
+    {
+        return;
+    }
+    auto &pool = sharedPool();
+    if (count == 1 || pool.workerCount() == 0)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            body(i);
+        }
+        return;
+    }
+
+    // Several chunks per thread keeps the load balanced when items differ in cost.
+    const std::size_t threads = pool.workerCount() + 1;
+    auto state = std::make_shared<ForState>();
+    state->count = count;
+    state->chunk = std::max<std::size_t>(1, count / (threads * 8));
+    state->body = body;
+
+    const std::size_t chunks = (count + state->chunk - 1) / state->chunk;
+    const std::size_t helpers = std::min<std::size_t>(pool.workerCount(), chunks - 1);
+    for (std::size_t i = 0; i < helpers; ++i)
+    {
+        pool.submit([state] { runChunks(*state); });
+    }
+    runChunks(*state);
+
+    std::unique_lock lock(state->mutex);
+    state->done.wait(lock, [&] { return state->finished.load() == state->count; });
+    if (state->error)
+    {
+        std::rethrow_exception(state->error);
+    }
+}
+
+} // namespace common::parallel
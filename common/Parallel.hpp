@@ -0,0 +1,162 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <iostream>
+#include <mutex>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "Config.hpp"
+
+namespace common::parallel
+{
+/// @brief Sets how many threads (the caller included) parallel helpers may use.
+/// 0 selects std::thread::hardware_concurrency(). Takes effect before the shared pool is
+/// first used; the runner sets it from --threads / AOC_THREADS.
+void setThreadCount(unsigned count);
+
+/// @brief Effective thread count, always at least 1.
+unsigned threadCount();
+
+/// @brief Fixed-size pool of worker threads draining a FIFO task queue.
+class ThreadPool
+{
+public:
+    explicit ThreadPool(unsigned workers);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    void submit(std::function<void()> task);
+    unsigned workerCount() const noexcept { return static_cast<unsigned>(m_workers.size()); }
+
+private:
+    void workerLoop();
+
+    std::vector<std::thread> m_workers;
+    std::deque<std::function<void()>> m_tasks;
+    std::mutex m_mutex;
+    std::condition_variable m_ready;
+    bool m_stopping = false;
+};
+
+/// @brief Process-wide pool with threadCount() - 1 workers; the calling thread makes up the rest.
+ThreadPool &sharedPool();
+
+/// @brief Runs body(i) for every i in [0, count) on the shared pool and waits for all of them.
+/// The caller claims chunks too, so nested calls from inside a pool task cannot deadlock.
+/// The first exception thrown by body is rethrown once every index has been accounted for.
+void parallelFor(std::size_t count, const std::function<void(std::size_t)> &body);
+
+/// @brief Per-task diagnostics buffer. Writes are dropped unless verbose output is enabled,
+/// so solvers can log freely without formatting cost on normal runs.
+class TaskLog
+{
+public:
+    explicit TaskLog(std::size_t index = 0, bool enabled = isVerbose()) : m_index(index)
+    {
+        if (enabled)
+        {
+            m_stream.emplace();
+        }
+    }
+
+    /// @brief Position of the task's item in the input, for labelling messages.
+    std::size_t index() const noexcept { return m_index; }
+    bool enabled() const noexcept { return m_stream.has_value(); }
+    std::string str() const { return m_stream ? m_stream->str() : std::string(); }
+
+    template <typename T>
+    TaskLog &operator<<(const T &value)
+    {
+        if (m_stream)
+        {
+            *m_stream << value;
+        }
+        return *this;
+    }
+
+    TaskLog &operator<<(std::ostream &(*manipulator)(std::ostream &))
+    {
+        if (m_stream)
+        {
+            *m_stream << manipulator;
+        }
+        return *this;
+    }
+
+private:
+    std::size_t m_index;
+    std::optional<std::ostringstream> m_stream;
+};
+
+namespace detail
+{
+template <typename Solve, typename Parsed, bool WithLog>
+struct SolveResult
+{
+    using type = std::invoke_result_t<Solve, Parsed>;
+};
+
+template <typename Solve, typename Parsed>
+struct SolveResult<Solve, Parsed, true>
+{
+    using type = std::invoke_result_t<Solve, Parsed, TaskLog &>;
+};
+} // namespace detail
+
+/// @brief Parses and solves every line independently on the shared pool, then folds the
+/// results in line order: combine(combine(R{}, r0), r1)...
+/// solve is called as solve(parsed, TaskLog &) when it accepts a log, otherwise solve(parsed).
+/// Buffered logs are written to std::cerr in line order after all tasks finish (verbose only).
+template <typename Parse, typename Solve, typename Combine>
+auto mapReduce(const std::vector<std::string> &lines, Parse &&parse, Solve &&solve, Combine &&combine)
+{
+    using Parsed = std::decay_t<std::invoke_result_t<Parse &, const std::string &>>;
+    constexpr bool kWantsLog = std::is_invocable_v<Solve &, Parsed &, TaskLog &>;
+    using Result = std::decay_t<typename detail::SolveResult<Solve &, Parsed &, kWantsLog>::type>;
+
+    const bool verbose = isVerbose();
+    std::vector<Result> results(lines.size());
+    std::vector<std::string> logs(kWantsLog && verbose ? lines.size() : 0);
+
+    parallelFor(lines.size(), [&](std::size_t i) {
+        Parsed parsed = parse(lines[i]);
+        if constexpr (kWantsLog)
+        {
+            TaskLog log(i, verbose);
+            results[i] = solve(parsed, log);
+            if (verbose)
+            {
+                logs[i] = log.str();
+            }
+        }
+        else
+        {
+            results[i] = solve(parsed);
+        }
+    });
+
+    for (const auto &log : logs)
+    {
+        std::cerr << log;
+    }
+
+    Result total{};
+    for (auto &result : results)
+    {
+        total = combine(std::move(total), std::move(result));
+    }
+    return total;
+}
+
+} // namespace common::parallel
@@ -0,0 +1,193 @@
+#include "PerfCounters.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <iomanip>
+#include <sstream>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace common::perf
+{
+namespace
+{
+constexpr std::array<const char *, kCounterCount> kCounterNames = {
+    "cycles", "instructions", "cache misses", "branch misses", "page faults",
+};
+
+std::string formatCount(uint64_t value)
+{
+    static constexpr std::array<const char *, 4> kSuffixes = {"", "K", "M", "G"};
+    double scaled = static_cast<double>(value);
+    std::size_t suffix = 0;
+    while (scaled >= 1000.0 && suffix + 1 < kSuffixes.size())
+    {
+        scaled /= 1000.0;
+        ++suffix;
+    }
+    std::ostringstream out;
+    if (suffix == 0)
+    {
+        out << value;
+    }
+    else
+    {
+        out << std::fixed << std::setprecision(2) << scaled << kSuffixes[suffix];
+    }
+    return out.str();
+}
+
+#ifdef __linux__
+struct EventSpec
+{
+    uint32_t type;
+    uint64_t config;
+};
+
+constexpr std::array<EventSpec, kCounterCount> kEvents = {{
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    {PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS},
+}};
+
+int openCounter(const EventSpec &spec)
+{
+    perf_event_attr attr{};
+    attr.size = sizeof(attr);
+    attr.type = spec.type;
+    attr.config = spec.config;
+    attr.disabled = 1;
+    attr.inherit = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, PERF_FLAG_FD_CLOEXEC));
+}
+#endif
+} // namespace
+
+std::optional<double> Reading::ipc() const
+{
+    const auto cycles = get(Counter::Cycles);
+    const auto instructions = get(Counter::Instructions);
+    if (!cycles || !instructions || *cycles == 0)
+    {
+        return std::nullopt;
+    }
+    return static_cast<double>(*instructions) / static_cast<double>(*cycles);
+}
+
+PerfCounters::PerfCounters()
+{
+    m_fds.fill(-1);
+#ifdef __linux__
+    for (std::size_t i = 0; i < kCounterCount; ++i)
+    {
+        m_fds[i] = openCounter(kEvents[i]);
+        if (m_fds[i] < 0 && m_reason.empty())
+        {
+            m_reason = std::string(kCounterNames[i]) + ": " + std::strerror(errno);
+        }
+    }
+#else
+    m_reason = "perf_event_open is only available on Linux";
+#endif
+}
+
+PerfCounters::~PerfCounters()
+{
+#ifdef __linux__
+    for (const int fd : m_fds)
+    {
+        if (fd >= 0)
+        {
+            close(fd);
+        }
+    }
+#endif
+}
+
+bool PerfCounters::available() const noexcept
+{
+    for (const int fd : m_fds)
+    {
+        if (fd >= 0)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void PerfCounters::start()
+{
+#ifdef __linux__
+    for (const int fd : m_fds)
+    {
+        if (fd >= 0)
+        {
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+    }
+#endif
+}
+
+Reading PerfCounters::stop()
+{
+    Reading reading;
+#ifdef __linux__
+    for (const int fd : m_fds)
+    {
+        if (fd >= 0)
+        {
+            ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+        }
+    }
+    for (std::size_t i = 0; i < kCounterCount; ++i)
+    {
+        // value, time enabled, time running
+        uint64_t data[3] = {};
+        if (m_fds[i] < 0 || read(m_fds[i], data, sizeof(data)) != static_cast<ssize_t>(sizeof(data)) || data[2] == 0)
+        {
+            continue;
+        }
+        if (data[2] < data[1])
+        {
+            // The PMU was shared with other events; extrapolate to the whole region.
+            data[0] = static_cast<uint64_t>(static_cast<double>(data[0]) * static_cast<double>(data[1]) /
+                                            static_cast<double>(data[2]));
+        }
+        reading.values[i] = data[0];
+    }
+#endif
+    return reading;
+}
+
+std::string formatReading(const Reading &reading)
+{
+    std::ostringstream out;
+    for (std::size_t i = 0; i < kCounterCount; ++i)
+    {
+        out << (i == 0 ? "" : ", ");
+        const auto value = reading.values[i];
+        out << (value ? formatCount(*value) : "n/a") << ' ' << kCounterNames[i];
+        if (static_cast<Counter>(i) == Counter::Instructions)
+        {
+            if (const auto ipc = reading.ipc())
+            {
+                out << " (IPC " << std::fixed << std::setprecision(2) << *ipc << ')';
+            }
+        }
+    }
+    return out.str();
+}
+
+} // namespace common::perf
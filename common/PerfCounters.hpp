@@ -0,0 +1,71 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace common::perf
+{
+enum class Counter : std::size_t
+{
+    Cycles,
+    Instructions,
+    CacheMisses,
+    BranchMisses,
+    PageFaults,
+};
+
+inline constexpr std::size_t kCounterCount = 5;
+
+/// @brief Counter values for one measured region; a counter that could not be opened is empty.
+struct Reading
+{
+    std::array<std::optional<uint64_t>, kCounterCount> values;
+
+    std::optional<uint64_t> get(Counter counter) const { return values[static_cast<std::size_t>(counter)]; }
+
+    /// @brief Instructions per cycle, when both counters were available.
+    std::optional<double> ipc() const;
+};
+
+/**
+ * @brief User-space hardware and software counters for the calling process, via perf_event_open.
+ *
+ * Each counter is opened on its own, so a kernel or container that only exposes some of them
+ * (typically page faults without a hardware PMU) still reports those. Threads created after
+ * construction are counted too, which is why the runner builds this before the shared pool
+ * starts. Off Linux, or when perf_event_paranoid forbids access, nothing is opened and
+ * available() is false; start() and stop() are then no-ops.
+ */
+class PerfCounters
+{
+public:
+    PerfCounters();
+    ~PerfCounters();
+
+    PerfCounters(const PerfCounters &) = delete;
+    PerfCounters &operator=(const PerfCounters &) = delete;
+
+    /// @brief True if at least one counter could be opened.
+    bool available() const noexcept;
+
+    /// @brief Why the first counter that failed to open did so (empty if all opened).
+    const std::string &unavailableReason() const noexcept { return m_reason; }
+
+    /// @brief Zeroes and enables every open counter.
+    void start();
+
+    /// @brief Disables the counters and reads them, scaled up if the kernel multiplexed them.
+    Reading stop();
+
+private:
+    std::array<int, kCounterCount> m_fds;
+    std::string m_reason;
+};
+
+/// @brief One-line summary, e.g. "1.20G cycles, 2.41G instructions (IPC 2.01), ...".
+std::string formatReading(const Reading &reading);
+
+} // namespace common::perf
@@ -0,0 +1,195 @@
+#include "Results.hpp"
+
+#include <array>
+#include <cstdio>
+#include <iomanip>
+#include <sstream>
+#include <utility>
+#include <vector>
+
+#include "Bench.hpp"
+
+namespace common::results
+{
+namespace
+{
+constexpr std::array<perf::Counter, perf::kCounterCount> kCounters = {
+    perf::Counter::Cycles,       perf::Counter::Instructions, perf::Counter::CacheMisses,
+    perf::Counter::BranchMisses, perf::Counter::PageFaults,
+};
+constexpr std::array<const char *, perf::kCounterCount> kCounterFields = {
+    "cycles", "instructions", "cache_misses", "branch_misses", "page_faults",
+};
+
+/// Every scalar field of a record, in output order; empty strings are missing values.
+std::vector<std::pair<const char *, std::string>> scalarFields(const Record &record)
+{
+    const auto number = [](auto value) {
+        std::ostringstream out;
+        out << std::setprecision(9) << value;
+        return out.str();
+    };
+
+    std::vector<std::pair<const char *, std::string>> fields;
+    fields.emplace_back("runs", number(record.samples.size()));
+    fields.emplace_back("inputs", record.inputs ? number(*record.inputs) : "");
+    if (!record.samples.empty())
+    {
+        const auto summary = bench::summarize(record.samples);
+        fields.emplace_back("min", number(summary.min));
+        fields.emplace_back("median", number(summary.median));
+        fields.emplace_back("mean", number(summary.mean));
+        fields.emplace_back("p99", number(summary.p99));
+        fields.emplace_back("max", number(summary.max));
+        fields.emplace_back("stddev", number(summary.stddev));
+    }
+    else
+    {
+        for (const char *name : {"min", "median", "mean", "p99", "max", "stddev"})
+        {
+            fields.emplace_back(name, "");
+        }
+    }
+
+    const auto &allocations = record.allocations;
+    fields.emplace_back("allocations", allocations ? number(allocations->allocations) : "");
+    fields.emplace_back("frees", allocations ? number(allocations->frees) : "");
+    fields.emplace_back("bytes", allocations ? number(allocations->bytes) : "");
+    fields.emplace_back("peak_live_bytes", allocations ? number(allocations->peakLiveBytes) : "");
+    fields.emplace_back("peak_rss_bytes", record.peakRssBytes ? number(*record.peakRssBytes) : "");
+
+    for (std::size_t i = 0; i < kCounters.size(); ++i)
+    {
+        const auto value = record.counters ? record.counters->get(kCounters[i]) : std::nullopt;
+        fields.emplace_back(kCounterFields[i], value ? number(*value) : "");
+    }
+    const auto ipc = record.counters ? record.counters->ipc() : std::nullopt;
+    fields.emplace_back("ipc", ipc ? number(*ipc) : "");
+    return fields;
+}
+
+std::string csvCell(std::string_view text)
+{
+    if (text.find_first_of(",\"\n") == std::string_view::npos)
+    {
+        return std::string(text);
+    }
+    std::string quoted = "\"";
+    for (const char c : text)
+    {
+        quoted += c;
+        if (c == '"')
+        {
+            quoted += '"';
+        }
+    }
+    return quoted + '"';
+}
+} // namespace
+
+std::optional<Format> parseFormat(std::string_view name)
+{
+    if (name == "text")
+    {
+        return Format::Text;
+    }
+    if (name == "json")
+    {
+        return Format::Json;
+    }
+    if (name == "csv")
+    {
+        return Format::Csv;
+    }
+    return std::nullopt;
+}
+
+void writeJson(std::ostream &out, const std::vector<Record> &records)
+{
+    const auto precision = out.precision();
+    out << std::setprecision(9);
+    out << "{\n  \"schema\": " << kSchemaVersion << ",\n  \"unit\": \"s\",\n  \"results\": [";
+    for (std::size_t i = 0; i < records.size(); ++i)
+    {
+        const auto &record = records[i];
+        out << (i == 0 ? "\n" : ",\n") << "    {\"day\": " << jsonQuote(record.day)
+            << ", \"phase\": " << jsonQuote(record.phase);
+        if (!record.answer.empty())
+        {
+            out << ", \"answer\": " << jsonQuote(record.answer);
+        }
+        for (const auto &[name, value] : scalarFields(record))
+        {
+            if (!value.empty())
+            {
+                out << ", \"" << name << "\": " << value;
+            }
+        }
+        out << ", \"samples\": [";
+        for (std::size_t s = 0; s < record.samples.size(); ++s)
+        {
+            out << (s == 0 ? "" : ", ") << record.samples[s];
+        }
+        out << "]}";
+    }
+    out << "\n  ]\n}" << std::endl;
+    out.precision(precision);
+}
+
+void writeCsv(std::ostream &out, const std::vector<Record> &records)
+{
+    out << "day,phase,answer";
+    for (const auto &[name, value] : scalarFields(Record{}))
+    {
+        out << ',' << name;
+    }
+    out << '\n';
+    for (const auto &record : records)
+    {
+        out << csvCell(record.day) << ',' << csvCell(record.phase) << ',' << csvCell(record.answer);
+        for (const auto &[name, value] : scalarFields(record))
+        {
+            out << ',' << value;
+        }
+        out << '\n';
+    }
+    out << std::flush;
+}
+
+std::string jsonQuote(std::string_view text)
+{
+    std::string quoted = "\"";
+    for (const char c : text)
+    {
+        switch (c)
+        {
+        case '"':
+            quoted += "\\\"";
+            break;
+        case '\\':
+            quoted += "\\\\";
+            break;
+        case '\n':
+            quoted += "\\n";
+            break;
+        case '\t':
+            quoted += "\\t";
+            break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20)
+            {
+                char escape[7];
+                std::snprintf(escape, sizeof(escape), "\\u%04x", static_cast<unsigned>(c));
+                quoted += escape;
+            }
+            else
+            {
+                quoted += c;
+            }
+        }
+    }
+    quoted += '"';
+    return quoted;
+}
+
+} // namespace common::results
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "AllocTracker.hpp"
+#include "PerfCounters.hpp"
+
+namespace common::results
+{
+/// @brief How the runner reports results on stdout.
+enum class Format
+{
+    Text,
+    Json,
+    Csv,
+};
+
+/// @brief "text", "json" or "csv"; std::nullopt for anything else.
+std::optional<Format> parseFormat(std::string_view name);
+
+/**
+ * @brief One measured phase of one day, the unit the comparison tool (util/compare-results.py)
+ * matches between two result files.
+ *
+ * phase is "load", "parse", "part1", "part2", "total" for a whole-run wall time, or "batch"
+ * for the wall time of a --inputs run. samples holds one wall time per timed run, in seconds.
+ */
+struct Record
+{
+    // Every field has a default, so records are built with designated initializers naming
+    // only what they set.
+    std::string day{};
+    std::string phase{};
+    /// Solver answer; empty for phases that do not produce one.
+    std::string answer{};
+    std::vector<double> samples{};
+    /// Number of inputs a batch record covers.
+    std::optional<uint64_t> inputs{};
+    std::optional<alloc::Stats> allocations{};
+    std::optional<uint64_t> peakRssBytes{};
+    std::optional<perf::Reading> counters{};
+};
+
+/// @brief Version of the JSON/CSV layout; bump it when fields change meaning.
+inline constexpr int kSchemaVersion = 1;
+
+/// @brief {"schema": 1, "results": [...]}, one object per record with summary statistics
+/// (min/median/mean/p99/max/stddev), raw samples, and memory/perf fields when present.
+void writeJson(std::ostream &out, const std::vector<Record> &records);
+
+/// @brief A header row and one row per record with the same fields as JSON except the raw
+/// samples; missing values are empty cells.
+void writeCsv(std::ostream &out, const std::vector<Record> &records);
+
+/// @brief text as a quoted JSON string literal.
+std::string jsonQuote(std::string_view text);
+
+} // namespace common::results
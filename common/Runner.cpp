@@ -2,12 +2,28 @@
 
 #include <chrono>
 #include <filesystem>
+#include <fstream>
 #include <functional>
+#include <future>
 #include <iostream>
+#include <iterator>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include <gtest/gtest.h>
 
+#include "AllocTracker.hpp"
+#include "Batch.hpp"
+#include "Bench.hpp"
+#include "Generator.hpp"
 #include "InputFile.hpp"
+#include "Parallel.hpp"
+#include "PerfCounters.hpp"
+#include "Results.hpp"
+#include "Server.hpp"
 #include "TestHarness.hpp"
 
 namespace common
@@ -48,11 +64,19 @@ int runSampleCases(tests::Part part,
     }
 
     std::cout << "Running sample cases for part " << partNumber << ':' << std::endl;
+
+    // Cases are independent, so solve them concurrently and report in order.
+    std::vector<std::string> results(cases.size());
+    parallel::parallelFor(cases.size(), [&](std::size_t i) {
+        const auto input = tests::makeInput(cases[i]);
+        results[i] = solver(input);
+    });
+
     int caseIndex = 1;
-    for (const auto &testCase : cases)
+    for (std::size_t i = 0; i < cases.size(); ++i)
     {
-        const auto input = tests::makeInput(testCase);
-        const auto result = solver(input);
+        const auto &testCase = cases[i];
+        const auto &result = results[i];
         std::cout << "  [" << caseIndex++ << "] " << testCase.name << ": " << result;
         if (!testCase.expected.empty())
         {
@@ -100,39 +124,319 @@ int runSampleMode(const RunOptions &options,
     return 0;
 }
 
+/// Optional measurements taken around a part in addition to wall time. Both are process-wide,
+/// so they cannot be attributed to one part while another runs concurrently.
+struct Probes
+{
+    perf::PerfCounters *counters = nullptr;
+    bool allocations = false;
+};
+
+struct ProbeReadings
+{
+    std::optional<perf::Reading> counters;
+    std::optional<alloc::Stats> allocations;
+};
+
+void startProbes(const Probes &probes)
+{
+    if (probes.allocations)
+    {
+        alloc::reset();
+    }
+    if (probes.counters)
+    {
+        probes.counters->start();
+    }
+}
+
+ProbeReadings stopProbes(const Probes &probes)
+{
+    ProbeReadings readings;
+    if (probes.counters)
+    {
+        readings.counters = probes.counters->stop();
+    }
+    if (probes.allocations)
+    {
+        readings.allocations = alloc::snapshot();
+    }
+    return readings;
+}
+
+void printProbeReadings(const ProbeReadings &readings, std::string_view scope)
+{
+    if (readings.counters)
+    {
+        std::cout << "  perf" << scope << ": " << perf::formatReading(*readings.counters) << std::endl;
+    }
+    if (readings.allocations)
+    {
+        std::cout << "  alloc" << scope << ": " << alloc::formatStats(*readings.allocations) << "; peak RSS "
+                  << alloc::formatBytes(static_cast<double>(alloc::peakRssBytes())) << std::endl;
+    }
+}
+
+struct PartRun
+{
+    std::string result;
+    double seconds = 0.0;
+    ProbeReadings probes{};
+};
+
+PartRun timePart(const std::function<std::string(const InputFile &)> &solver,
+                 const InputFile &input,
+                 const Probes &probes = {})
+{
+    startProbes(probes);
+    const auto start = Clock::now();
+    PartRun run{solver(input)};
+    const std::chrono::duration<double> elapsed = Clock::now() - start;
+    run.seconds = elapsed.count();
+    run.probes = stopProbes(probes);
+    return run;
+}
+
+void printPartRun(std::string_view label, const PartRun &run, bool color)
+{
+    printResult(label, run.result, run.seconds, color);
+    printProbeReadings(run.probes, "");
+}
+
+std::string readFileText(const std::filesystem::path &path)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open())
+    {
+        throw std::runtime_error("Could not open file: " + path.string());
+    }
+    return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+}
+
+/// The phase record of a part run, with whatever probes were active.
+results::Record partRecord(std::string_view dayId, std::string phase, const PartRun &run)
+{
+    results::Record record{.day = std::string(dayId), .phase = std::move(phase), .answer = run.result, .samples = {run.seconds}};
+    record.counters = run.probes.counters;
+    record.allocations = run.probes.allocations;
+    if (run.probes.allocations)
+    {
+        record.peakRssBytes = alloc::peakRssBytes();
+    }
+    return record;
+}
+
+void writeRecords(results::Format format, const std::vector<results::Record> &records)
+{
+    if (format == results::Format::Json)
+    {
+        results::writeJson(std::cout, records);
+    }
+    else if (format == results::Format::Csv)
+    {
+        results::writeCsv(std::cout, records);
+    }
+}
+
 int runPuzzleMode(const RunOptions &options,
+                  std::string_view dayId,
                   const std::function<std::string(const InputFile &)> &part1,
-                  const std::function<std::string(const InputFile &)> &part2)
+                  const std::function<std::string(const InputFile &)> &part2,
+                  const Probes &probes)
 {
     if (!options.runPart1 && !options.runPart2)
     {
         std::cout << "All parts disabled; nothing to run." << std::endl;
         return 0;
     }
+    // Machine-readable formats keep stdout for the records alone.
+    const bool textOutput = options.format == results::Format::Text;
 
-    InputFile input(options.inputPath.string());
+    std::string contents;
+    const double loadSeconds = bench::timeSeconds([&] {
+        try
+        {
+            contents = readFileText(options.inputPath);
+        }
+        catch (const std::runtime_error &error)
+        {
+            (textOutput ? std::cout : std::cerr) << error.what() << std::endl;
+        }
+    });
+    std::optional<InputFile> parsed;
+    const double parseSeconds =
+        bench::timeSeconds([&] { parsed.emplace(InputFile::fromText(contents, options.inputPath.string())); });
+    const InputFile &input = *parsed;
 
-    if (options.runPart1)
+    const auto wallStart = Clock::now();
+    std::optional<PartRun> part1Run;
+    std::optional<PartRun> part2Run;
+    std::optional<ProbeReadings> combinedProbes;
+    if (options.parallelParts && options.runPart1 && options.runPart2)
     {
-        const auto start = Clock::now();
-        const auto result = part1(input);
-        const auto end = Clock::now();
-        const std::chrono::duration<double> elapsed = end - start;
-        printResult("Part 1", result, elapsed.count(), options.colorOutput);
+        // Both parts share the parsed input; its lazy caches are once-initialised. The
+        // probes cannot tell the parts apart, so they cover both together.
+        startProbes(probes);
+        auto part2Future = std::async(std::launch::async, [&] { return timePart(part2, input); });
+        part1Run = timePart(part1, input);
+        part2Run = part2Future.get();
+        combinedProbes = stopProbes(probes);
     }
+    else
+    {
+        if (options.runPart1)
+        {
+            part1Run = timePart(part1, input, probes);
+            if (textOutput)
+            {
+                printPartRun("Part 1", *part1Run, options.colorOutput);
+            }
+        }
+        if (options.runPart2)
+        {
+            part2Run = timePart(part2, input, probes);
+            if (textOutput)
+            {
+                printPartRun("Part 2", *part2Run, options.colorOutput);
+            }
+        }
+    }
+    const std::chrono::duration<double> wall = Clock::now() - wallStart;
 
-    if (options.runPart2)
+    if (!textOutput)
+    {
+        std::vector<results::Record> records;
+        records.push_back({.day = std::string(dayId), .phase = "load", .samples = {loadSeconds}});
+        records.push_back({.day = std::string(dayId), .phase = "parse", .samples = {parseSeconds}});
+        if (part1Run)
+        {
+            records.push_back(partRecord(dayId, "part1", *part1Run));
+        }
+        if (part2Run)
+        {
+            records.push_back(partRecord(dayId, "part2", *part2Run));
+        }
+        if (part1Run && part2Run)
+        {
+            PartRun total{{}, wall.count(), combinedProbes.value_or(ProbeReadings{})};
+            records.push_back(partRecord(dayId, "total", total));
+        }
+        writeRecords(options.format, records);
+        return 0;
+    }
+
+    if (options.parallelParts && part1Run && part2Run)
     {
-        const auto start = Clock::now();
-        const auto result = part2(input);
-        const auto end = Clock::now();
-        const std::chrono::duration<double> elapsed = end - start;
-        printResult("Part 2", result, elapsed.count(), options.colorOutput);
+        printPartRun("Part 1", *part1Run, options.colorOutput);
+        printPartRun("Part 2", *part2Run, options.colorOutput);
+        printProbeReadings(*combinedProbes, " (both parts)");
+    }
+    if (part1Run && part2Run)
+    {
+        std::cout << "Total: " << wall.count() << "s wall"
+                  << (options.parallelParts ? " (parts in parallel)" : "") << std::endl;
     }
 
     return 0;
 }
 
+int runBenchMode(const RunOptions &options,
+                 std::string_view dayId,
+                 const std::function<std::string(const InputFile &)> &part1,
+                 const std::function<std::string(const InputFile &)> &part2)
+{
+    if (!options.runPart1 && !options.runPart2)
+    {
+        std::cout << "All parts disabled; nothing to run." << std::endl;
+        return 0;
+    }
+
+    bench::Report report{std::string(dayId), options.inputPath.string(), options.benchWarmup, options.benchRuns, {}};
+    report.phases.push_back({"load", {}, {}});
+    report.phases.push_back({"parse", {}, {}});
+    std::vector<std::pair<const std::function<std::string(const InputFile &)> *, std::size_t>> parts;
+    if (options.runPart1)
+    {
+        parts.emplace_back(&part1, report.phases.size());
+        report.phases.push_back({"Part 1", {}, {}});
+    }
+    if (options.runPart2)
+    {
+        parts.emplace_back(&part2, report.phases.size());
+        report.phases.push_back({"Part 2", {}, {}});
+    }
+
+    bool consistent = true;
+    for (unsigned run = 0; run < options.benchWarmup + options.benchRuns; ++run)
+    {
+        const bool measured = run >= options.benchWarmup;
+        std::string text;
+        const double loadSeconds = bench::timeSeconds([&] { text = readFileText(options.inputPath); });
+        std::optional<InputFile> parsed;
+        const double parseSeconds =
+            bench::timeSeconds([&] { parsed.emplace(InputFile::fromText(text, options.inputPath.string())); });
+        if (measured)
+        {
+            report.phases[0].samples.push_back(loadSeconds);
+            report.phases[1].samples.push_back(parseSeconds);
+        }
+
+        for (const auto &[solver, phaseIndex] : parts)
+        {
+            // A copy starts with empty lazy caches, so no part reuses views built by an
+            // earlier part or run.
+            const InputFile input = *parsed;
+            std::string result;
+            const double solveSeconds = bench::timeSeconds([&] { result = (*solver)(input); });
+            auto &phase = report.phases[phaseIndex];
+            if (run == 0)
+            {
+                phase.result = result;
+            }
+            else if (result != phase.result)
+            {
+                std::cerr << phase.name << " returned " << result << " on run " << run + 1 << " but "
+                          << phase.result << " on run 1." << std::endl;
+                consistent = false;
+            }
+            if (measured)
+            {
+                phase.samples.push_back(solveSeconds);
+            }
+        }
+    }
+
+    std::vector<results::Record> records;
+    for (const auto &phase : report.phases)
+    {
+        std::string id = phase.name == "Part 1" ? "part1" : phase.name == "Part 2" ? "part2" : phase.name;
+        records.push_back({.day = report.day, .phase = std::move(id), .answer = phase.result, .samples = phase.samples});
+    }
+
+    if (options.format != results::Format::Text || options.benchJsonPath == "-")
+    {
+        writeRecords(options.benchJsonPath == "-" ? results::Format::Json : options.format, records);
+        return consistent ? 0 : 1;
+    }
+    for (const auto &[solver, phaseIndex] : parts)
+    {
+        const auto &phase = report.phases[phaseIndex];
+        std::cout << phase.name << ": " << colorize(phase.result, options.colorOutput, "32") << std::endl;
+    }
+    bench::printTable(std::cout, report);
+    if (!options.benchJsonPath.empty())
+    {
+        std::ofstream json(options.benchJsonPath);
+        if (!json.is_open())
+        {
+            std::cerr << "Could not write benchmark report to " << options.benchJsonPath.string() << std::endl;
+            return 1;
+        }
+        results::writeJson(json, records);
+    }
+    return consistent ? 0 : 1;
+}
+
 } // namespace
 
 int runDayWithAdapters(int argc,
@@ -140,10 +444,34 @@ int runDayWithAdapters(int argc,
                        std::string_view dayId,
                        std::string_view sourcePath,
                        std::function<std::string(const InputFile &)> part1,
-                       std::function<std::string(const InputFile &)> part2)
+                       std::function<std::string(const InputFile &)> part2,
+                       gen::Generator generator)
 {
     RunOptions options = buildRunOptions(dayId, sourcePath, argc, argv);
     tests::setTestsRoot(options.testsPath);
+    setVerbose(options.verbose);
+    parallel::setThreadCount(options.threads);
+
+    // Opened before anything starts the shared pool, so its workers inherit the counters.
+    std::optional<perf::PerfCounters> counters;
+    if (options.perf)
+    {
+        counters.emplace();
+        if (!counters->available())
+        {
+            std::cerr << "perf: counters unavailable (" << counters->unavailableReason()
+                      << "); check /proc/sys/kernel/perf_event_paranoid or container seccomp settings."
+                      << std::endl;
+            counters.reset();
+        }
+        else if (!counters->unavailableReason().empty())
+        {
+            std::cerr << "perf: some counters unavailable (" << counters->unavailableReason() << ")."
+                      << std::endl;
+        }
+    }
+    const Probes probes{counters ? &*counters : nullptr, options.allocations};
+    alloc::setTracking(options.allocations);
 
     if (options.samplesOnly && options.inputOnly)
     {
@@ -153,14 +481,88 @@ int runDayWithAdapters(int argc,
 
     tests::setEnabledParts(options.runPart1, options.runPart2);
 
+    if (options.generateScale > 0)
+    {
+        if (options.samplesOnly || options.benchRuns > 0)
+        {
+            std::cerr << "Cannot combine --generate with --sample or --bench modes." << std::endl;
+            return 1;
+        }
+        if (!generator)
+        {
+            std::cerr << "Day " << dayId << " has no input generator." << std::endl;
+            return 1;
+        }
+        try
+        {
+            gen::writeTo(generator, {options.generateScale, options.generateSeed}, options.generateOutput);
+        }
+        catch (const std::exception &error)
+        {
+            std::cerr << error.what() << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    if (options.serve)
+    {
+        const DayEntry day{std::string(dayId), deduceDayDirectory(sourcePath), part1, part2, generator};
+        return server::serve({day}, options.serveSocket);
+    }
+
+    if (!options.batchInputs.empty() || !options.batchInputsFrom.empty())
+    {
+        if (options.samplesOnly || options.benchRuns > 0)
+        {
+            std::cerr << "Cannot combine --inputs with --sample or --bench modes." << std::endl;
+            return 1;
+        }
+        try
+        {
+            auto inputs = options.batchInputs.empty() ? std::vector<std::filesystem::path>{}
+                                                      : batch::expandInputs(options.batchInputs);
+            if (!options.batchInputsFrom.empty())
+            {
+                const auto listed = batch::readInputList(options.batchInputsFrom);
+                inputs.insert(inputs.end(), listed.begin(), listed.end());
+            }
+            return batch::runBatch(options, dayId, inputs, part1, part2);
+        }
+        catch (const std::exception &error)
+        {
+            std::cerr << error.what() << std::endl;
+            return 1;
+        }
+    }
+
+    if (options.benchRuns > 0)
+    {
+        if (options.samplesOnly)
+        {
+            std::cerr << "Cannot combine --sample and --bench modes." << std::endl;
+            return 1;
+        }
+        try
+        {
+            return runBenchMode(options, dayId, part1, part2);
+        }
+        catch (const std::exception &error)
+        {
+            std::cerr << error.what() << std::endl;
+            return 1;
+        }
+    }
+
     if (options.samplesOnly)
     {
         return runSampleMode(options, part1, part2);
     }
 
-    if (options.inputOnly)
+    // JSON/CSV must be the only thing on stdout, so those formats skip the GoogleTest run.
+    if (options.inputOnly || options.format != results::Format::Text)
     {
-        return runPuzzleMode(options, part1, part2);
+        return runPuzzleMode(options, dayId, part1, part2, probes);
     }
 
     ::testing::InitGoogleTest(&argc, argv);
@@ -177,7 +579,7 @@ int runDayWithAdapters(int argc,
         return testResult;
     }
 
-    return runPuzzleMode(options, part1, part2);
+    return runPuzzleMode(options, dayId, part1, part2, probes);
 }
 
 } // namespace detail
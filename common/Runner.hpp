@@ -6,8 +6,10 @@
 #include <vector>
 
 #include "Config.hpp"
+#include "Generator.hpp"
 #include "InputFile.hpp"
 #include "ResultAdapter.hpp"
+#include "SolverContext.hpp"
 
 namespace common
 {
@@ -18,7 +20,8 @@ int runDayWithAdapters(int argc,
                        std::string_view dayId,
                        std::string_view sourcePath,
                        std::function<std::string(const InputFile &)> part1,
-                       std::function<std::string(const InputFile &)> part2);
+                       std::function<std::string(const InputFile &)> part2,
+                       gen::Generator generator);
 }
 
 template <typename Part1Fn, typename Part2Fn>
@@ -27,20 +30,23 @@ int runDay(int argc,
            std::string_view dayId,
            std::string_view sourcePath,
            Part1Fn &&part1,
-           Part2Fn &&part2)
+           Part2Fn &&part2,
+           gen::Generator generator = {})
 {
+    // Solvers may take (const InputFile &) or (const InputFile &, SolverContext &).
     auto part1Adapter = [part1Fn = std::forward<Part1Fn>(part1)](const InputFile &input) {
-        return detail::normalizeResult(part1Fn(input));
+        return detail::invokeSolver(part1Fn, input, "Part 1");
     };
     auto part2Adapter = [part2Fn = std::forward<Part2Fn>(part2)](const InputFile &input) {
-        return detail::normalizeResult(part2Fn(input));
+        return detail::invokeSolver(part2Fn, input, "Part 2");
     };
     return detail::runDayWithAdapters(argc,
                                       argv,
                                       dayId,
                                       sourcePath,
                                       std::move(part1Adapter),
-                                      std::move(part2Adapter));
+                                      std::move(part2Adapter),
+                                      std::move(generator));
 }
 
 } // namespace common
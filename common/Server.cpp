@@ -0,0 +1,495 @@
+#include "Server.hpp"
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+#include "Bench.hpp"
+#include "InputFile.hpp"
+#include "Parallel.hpp"
+#include "StringUtils.hpp"
+
+namespace common::server
+{
+namespace
+{
+constexpr std::size_t kCachedInputs = 64;
+/// Most lines an inline request may announce; larger inputs should be sent as files.
+constexpr std::size_t kMaxInlineLines = 1'000'000;
+
+/// Parsed input files by path, reused while the file's size and modification time match.
+class InputCache
+{
+public:
+    std::shared_ptr<const InputFile> load(const std::filesystem::path &path)
+    {
+        std::error_code sizeError;
+        std::error_code timeError;
+        const auto size = std::filesystem::file_size(path, sizeError);
+        const auto modified = std::filesystem::last_write_time(path, timeError);
+        if (sizeError || timeError)
+        {
+            throw std::runtime_error("Could not open file: " + path.string());
+        }
+
+        const auto key = path.string();
+        {
+            std::lock_guard lock(m_mutex);
+            const auto found = m_entries.find(key);
+            if (found != m_entries.end() && found->second.size == size && found->second.modified == modified)
+            {
+                found->second.lastUse = ++m_clock;
+                return found->second.input;
+            }
+        }
+
+        // Read outside the lock so one large file does not stall other connections.
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open())
+        {
+            throw std::runtime_error("Could not open file: " + key);
+        }
+        const std::string text(std::istreambuf_iterator<char>(file), {});
+        auto input = std::make_shared<const InputFile>(InputFile::fromText(text, key));
+
+        std::lock_guard lock(m_mutex);
+        if (m_entries.size() >= kCachedInputs && !m_entries.contains(key))
+        {
+            auto oldest = m_entries.begin();
+            for (auto it = m_entries.begin(); it != m_entries.end(); ++it)
+            {
+                oldest = it->second.lastUse < oldest->second.lastUse ? it : oldest;
+            }
+            m_entries.erase(oldest);
+        }
+        m_entries[key] = {size, modified, input, ++m_clock};
+        return input;
+    }
+
+private:
+    struct Entry
+    {
+        std::uintmax_t size = 0;
+        std::filesystem::file_time_type modified;
+        std::shared_ptr<const InputFile> input;
+        uint64_t lastUse = 0;
+    };
+
+    std::mutex m_mutex;
+    std::unordered_map<std::string, Entry> m_entries;
+    uint64_t m_clock = 0;
+};
+
+/// One client's request and response stream.
+class Channel
+{
+public:
+    virtual ~Channel() = default;
+    /// Next line without its terminator; false at end of stream.
+    virtual bool readLine(std::string &line) = 0;
+    virtual void writeLine(std::string_view line) = 0;
+};
+
+class StreamChannel : public Channel
+{
+public:
+    StreamChannel(std::istream &in, std::ostream &out) : m_in(in), m_out(out) {}
+
+    bool readLine(std::string &line) override
+    {
+        if (!std::getline(m_in, line))
+        {
+            return false;
+        }
+        if (!line.empty() && line.back() == '\r')
+        {
+            line.pop_back();
+        }
+        return true;
+    }
+
+    void writeLine(std::string_view line) override { m_out << line << '\n' << std::flush; }
+
+private:
+    std::istream &m_in;
+    std::ostream &m_out;
+};
+
+class SocketChannel : public Channel
+{
+public:
+    explicit SocketChannel(int fd) : m_fd(fd) {}
+    ~SocketChannel() override { ::close(m_fd); }
+
+    SocketChannel(const SocketChannel &) = delete;
+    SocketChannel &operator=(const SocketChannel &) = delete;
+
+    bool readLine(std::string &line) override
+    {
+        std::size_t newline;
+        while ((newline = m_buffer.find('\n', m_scanned)) == std::string::npos)
+        {
+            m_scanned = m_buffer.size();
+            char chunk[4096];
+            const auto received = ::recv(m_fd, chunk, sizeof(chunk), 0);
+            if (received < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (received <= 0)
+            {
+                // A final line without a terminator still counts.
+                if (m_buffer.empty())
+                {
+                    return false;
+                }
+                line = std::exchange(m_buffer, {});
+                m_scanned = 0;
+                return true;
+            }
+            m_buffer.append(chunk, static_cast<std::size_t>(received));
+        }
+        line.assign(m_buffer, 0, newline > 0 && m_buffer[newline - 1] == '\r' ? newline - 1 : newline);
+        m_buffer.erase(0, newline + 1);
+        m_scanned = 0;
+        return true;
+    }
+
+    void writeLine(std::string_view line) override
+    {
+        std::string message(line);
+        message += '\n';
+        std::string_view rest(message);
+        while (!rest.empty())
+        {
+            const auto sent = ::send(m_fd, rest.data(), rest.size(), MSG_NOSIGNAL);
+            if (sent < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            if (sent <= 0)
+            {
+                return; // The client went away; its next read ends the session.
+            }
+            rest.remove_prefix(static_cast<std::size_t>(sent));
+        }
+    }
+
+private:
+    int m_fd;
+    std::string m_buffer;
+    /// Prefix of m_buffer already searched for a newline.
+    std::size_t m_scanned = 0;
+};
+
+/// A request the session cannot answer without losing its place in the stream, e.g. an
+/// inline payload too large to read. The session replies with the message and closes.
+class OutOfStep : public std::runtime_error
+{
+public:
+    using std::runtime_error::runtime_error;
+};
+
+/// Splits off the next space-separated word of rest.
+std::string_view nextWord(std::string_view &rest)
+{
+    while (rest.starts_with(' '))
+    {
+        rest.remove_prefix(1);
+    }
+    const auto end = std::min(rest.find(' '), rest.size());
+    const auto word = rest.substr(0, end);
+    rest.remove_prefix(end);
+    return word;
+}
+
+const DayEntry *findDay(const std::vector<DayEntry> &days, std::string_view id)
+{
+    const std::string padded = id.size() == 1 ? "0" + std::string(id) : std::string(id);
+    for (const auto &day : days)
+    {
+        if (day.id == padded)
+        {
+            return &day;
+        }
+    }
+    return nullptr;
+}
+
+/// Handles "<day> <part> file <path>" and "<day> <part> inline <count>" requests. Throws
+/// OutOfStep when the payload cannot be consumed; every other failure becomes an error reply.
+std::string solve(std::string_view request, Channel &channel, const std::vector<DayEntry> &days, InputCache &cache)
+{
+    try
+    {
+        std::string_view rest = request;
+        const auto dayId = nextWord(rest);
+        const auto part = nextWord(rest);
+        const auto source = nextWord(rest);
+        while (rest.starts_with(' '))
+        {
+            rest.remove_prefix(1);
+        }
+
+        std::shared_ptr<const InputFile> input;
+        if (source == "inline")
+        {
+            // Consume the payload before validating anything else so the stream stays in step.
+            std::size_t count = 0;
+            const auto [ptr, ec] = std::from_chars(rest.data(), rest.data() + rest.size(), count);
+            if (ec == std::errc::result_out_of_range || (ec == std::errc() && count > kMaxInlineLines))
+            {
+                throw OutOfStep("inline input too large");
+            }
+            if (ec != std::errc() || ptr != rest.data() + rest.size())
+            {
+                return "error invalid line count: " + std::string(rest);
+            }
+            std::vector<std::string> lines;
+            std::string line;
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                if (!channel.readLine(line))
+                {
+                    return "error inline input ended early";
+                }
+                lines.push_back(std::move(line));
+            }
+            input = std::make_shared<const InputFile>(InputFile::fromLines(std::move(lines), "<inline>"));
+        }
+        else if (source != "file" || rest.empty())
+        {
+            return "error expected <day> <part> file <path> or <day> <part> inline <count>";
+        }
+
+        const DayEntry *day = findDay(days, dayId);
+        if (!day)
+        {
+            return "error unknown day: " + std::string(dayId);
+        }
+        if (part != "1" && part != "2")
+        {
+            return "error part must be 1 or 2, not " + std::string(part);
+        }
+
+        if (!input)
+        {
+            input = cache.load(std::filesystem::path(rest));
+        }
+        const auto &solver = part == "1" ? day->part1 : day->part2;
+        std::string answer;
+        const double seconds = bench::timeSeconds([&] { answer = solver(*input); });
+        std::ostringstream response;
+        response << "ok " << answer << ' ' << seconds;
+        return response.str();
+    }
+    catch (const OutOfStep &)
+    {
+        throw;
+    }
+    catch (const std::exception &error)
+    {
+        return std::string("error ") + error.what();
+    }
+}
+
+/// Answers requests until the client quits or disconnects. Returns true when it asked the
+/// whole server to stop.
+bool runSession(Channel &channel, const std::vector<DayEntry> &days, InputCache &cache)
+{
+    std::string line;
+    while (channel.readLine(line))
+    {
+        const std::string_view request = str::trim_view(line);
+        if (request.empty())
+        {
+            continue;
+        }
+        if (request == "ping")
+        {
+            channel.writeLine("ok pong");
+        }
+        else if (request == "quit")
+        {
+            return false;
+        }
+        else if (request == "shutdown")
+        {
+            channel.writeLine("ok shutdown");
+            return true;
+        }
+        else
+        {
+            try
+            {
+                channel.writeLine(solve(request, channel, days, cache));
+            }
+            catch (const OutOfStep &error)
+            {
+                // The rest of the stream is unread payload, so the connection cannot go on.
+                channel.writeLine(std::string("error ") + error.what());
+                return false;
+            }
+        }
+    }
+    return false;
+}
+
+int serveSocket(const std::vector<DayEntry> &days, const std::filesystem::path &socketPath, InputCache &cache)
+{
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    const auto pathText = socketPath.string();
+    if (pathText.size() >= sizeof(address.sun_path))
+    {
+        std::cerr << "Socket path is too long: " << pathText << std::endl;
+        return 1;
+    }
+    std::memcpy(address.sun_path, pathText.c_str(), pathText.size() + 1);
+
+    const int listener = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listener < 0)
+    {
+        std::cerr << "socket: " << std::strerror(errno) << std::endl;
+        return 1;
+    }
+    // A socket file left by a server that did not shut down cleanly would make bind fail.
+    std::error_code ignored;
+    if (std::filesystem::is_socket(socketPath, ignored))
+    {
+        std::filesystem::remove(socketPath, ignored);
+    }
+    if (::bind(listener, reinterpret_cast<const sockaddr *>(&address), sizeof(address)) != 0 ||
+        ::listen(listener, SOMAXCONN) != 0)
+    {
+        std::cerr << "Could not listen on " << pathText << ": " << std::strerror(errno) << std::endl;
+        ::close(listener);
+        return 1;
+    }
+    std::cerr << "Serving " << days.size() << (days.size() == 1 ? " day" : " days") << " on " << pathText
+              << std::endl;
+
+    // Each connection gets its own thread. Finished sessions are joined as new clients
+    // arrive; on shutdown the remaining connections are shut down, so an idle client cannot
+    // keep the server alive, and every session is joined before the locals they use go away.
+    std::atomic<bool> stopping{false};
+    std::mutex clientsMutex;
+    std::vector<int> openClients;
+    std::unordered_map<std::size_t, std::thread> sessions;
+    std::vector<std::size_t> finishedSessions;
+    const auto reapFinished = [&] {
+        std::vector<std::size_t> finished;
+        {
+            std::lock_guard lock(clientsMutex);
+            finished.swap(finishedSessions);
+        }
+        for (const auto id : finished)
+        {
+            sessions.at(id).join();
+            sessions.erase(id);
+        }
+    };
+
+    for (std::size_t nextSession = 0; !stopping; ++nextSession)
+    {
+        const int client = ::accept4(listener, nullptr, nullptr, SOCK_CLOEXEC);
+        if (client < 0)
+        {
+            if (errno == EINTR && !stopping)
+            {
+                continue;
+            }
+            if (!stopping)
+            {
+                std::cerr << "accept: " << std::strerror(errno) << std::endl;
+            }
+            break;
+        }
+        reapFinished();
+        {
+            std::lock_guard lock(clientsMutex);
+            openClients.push_back(client);
+        }
+        sessions.emplace(nextSession, std::thread([&, client, id = nextSession] {
+            bool stopRequested = false;
+            {
+                SocketChannel channel(client);
+                try
+                {
+                    stopRequested = runSession(channel, days, cache);
+                }
+                catch (const std::exception &error)
+                {
+                    // Ends this connection only; the other sessions keep running.
+                    std::cerr << "session: " << error.what() << std::endl;
+                }
+                // Forget the descriptor before the channel closes it, so shutdown never
+                // touches a number the system has handed out again.
+                std::lock_guard lock(clientsMutex);
+                std::erase(openClients, client);
+                finishedSessions.push_back(id);
+            }
+            if (stopRequested && !stopping.exchange(true))
+            {
+                // Wakes the accept call above.
+                ::shutdown(listener, SHUT_RDWR);
+            }
+        }));
+    }
+
+    {
+        std::lock_guard lock(clientsMutex);
+        for (const int client : openClients)
+        {
+            ::shutdown(client, SHUT_RDWR);
+        }
+    }
+    for (auto &[id, session] : sessions)
+    {
+        session.join();
+    }
+    ::close(listener);
+    std::filesystem::remove(socketPath, ignored);
+    return 0;
+}
+} // namespace
+
+int serve(const std::vector<DayEntry> &days, const std::filesystem::path &socketPath)
+{
+    // Start the workers now rather than inside the first request's timing.
+    parallel::sharedPool();
+    if (socketPath.empty())
+    {
+        return serveStream(days, std::cin, std::cout);
+    }
+    InputCache cache;
+    return serveSocket(days, socketPath, cache);
+}
+
+int serveStream(const std::vector<DayEntry> &days, std::istream &in, std::ostream &out)
+{
+    InputCache cache;
+    StreamChannel channel(in, out);
+    runSession(channel, days, cache);
+    return 0;
+}
+
+} // namespace common::server
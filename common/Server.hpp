@@ -0,0 +1,37 @@
+#pragma once
+
+#include <filesystem>
+#include <iosfwd>
+#include <vector>
+
+#include "DayRegistry.hpp"
+
+namespace common::server
+{
+/**
+ * @brief Answers solve requests from a long-lived process instead of one launch per query.
+ *
+ * The protocol is line based. Each request is one line and gets one response line:
+ *
+ *     <day> <part> file <path>      solve part 1 or 2 of day on the file at path
+ *     <day> <part> inline <count>   ... on the <count> lines that follow the request
+ *     ping                          answers "ok pong"
+ *     quit                          closes the connection (ends a stdin session)
+ *     shutdown                      stops the server
+ *
+ * Responses are "ok <answer> <seconds>" or "error <message>". An inline request may
+ * announce at most a million lines; a larger count is answered with "error inline input
+ * too large" and the connection is closed, since its payload cannot be skipped. Parsed
+ * files are cached by path and reused while their size and modification time are
+ * unchanged, and the shared thread pool is started before the first request.
+ *
+ * @param socketPath Unix domain socket to listen on, one thread per connection; empty
+ *        serves a single session on stdin/stdout.
+ * @return Process exit code.
+ */
+int serve(const std::vector<DayEntry> &days, const std::filesystem::path &socketPath);
+
+/// @brief One session over a pair of streams, as serve() runs on stdin/stdout; for tests.
+int serveStream(const std::vector<DayEntry> &days, std::istream &in, std::ostream &out);
+
+} // namespace common::server
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "InputFile.hpp"
+#include "Parallel.hpp"
+#include "ResultAdapter.hpp"
+
+namespace common
+{
+/**
+ * @brief State owned by a single solver invocation.
+ *
+ * Solvers that take `(const InputFile &, SolverContext &)` get a fresh context per call and
+ * keep their working data in it instead of in file-static globals, so the same part can run
+ * on several inputs at once. Diagnostics go to a buffered log that is flushed in one piece
+ * when the invocation finishes (verbose runs only).
+ */
+class SolverContext
+{
+public:
+    explicit SolverContext(std::string label = {}) : m_label(std::move(label)) {}
+
+    SolverContext(const SolverContext &) = delete;
+    SolverContext &operator=(const SolverContext &) = delete;
+
+    ~SolverContext() { flushLog(); }
+
+    /// @brief What is being solved, e.g. "Part 1" or a sample case name.
+    const std::string &label() const noexcept { return m_label; }
+
+    parallel::TaskLog &log() noexcept { return m_log; }
+
+    /// @brief Writes any buffered diagnostics to std::cerr as a single block.
+    void flushLog()
+    {
+        const auto text = m_log.str();
+        if (text.empty())
+        {
+            return;
+        }
+        static std::mutex outputMutex;
+        std::lock_guard lock(outputMutex);
+        std::cerr << text << std::flush;
+        m_log = parallel::TaskLog();
+    }
+
+private:
+    std::string m_label;
+    parallel::TaskLog m_log;
+};
+
+namespace detail
+{
+/// @brief Calls a solver with or without a SolverContext, depending on what it accepts.
+template <typename Solver>
+std::string invokeSolver(Solver &&solver, const InputFile &input, std::string label = {})
+{
+    if constexpr (std::is_invocable_v<Solver &, const InputFile &, SolverContext &>)
+    {
+        SolverContext context(std::move(label));
+        return normalizeResult(solver(input, context));
+    }
+    else
+    {
+        return normalizeResult(solver(input));
+    }
+}
+} // namespace detail
+
+} // namespace common
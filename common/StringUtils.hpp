@@ -4,8 +4,12 @@
 #include <cctype>
 #include <charconv>
 #include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <iterator>
 #include <optional>
+#include <ranges>
 #include <stdexcept>
 #include <string>
 #include <string_view>
@@ -40,28 +44,163 @@ inline std::string_view trim_view(std::string_view input)
     return input;
 }
 
-inline std::vector<std::string> split(std::string_view input, char delimiter, bool skipEmpty = true)
+namespace detail
 {
-    std::vector<std::string> parts;
-    std::string current;
-    for (char ch : input)
+/// @brief Finds one delimiter character with memchr, which the C library vectorises.
+struct CharDelimiter
+{
+    char ch;
+
+    std::size_t find(std::string_view text) const noexcept
+    {
+        const void *hit = text.empty() ? nullptr : std::memchr(text.data(), ch, text.size());
+        return hit ? static_cast<std::size_t>(static_cast<const char *>(hit) - text.data()) : text.size();
+    }
+};
+
+/// @brief Finds the first of several delimiter characters through a 256-bit membership table.
+struct AnyOfDelimiters
+{
+    std::array<uint64_t, 4> table{};
+
+    AnyOfDelimiters() = default;
+    explicit AnyOfDelimiters(std::string_view chars) noexcept
+    {
+        for (const unsigned char c : chars)
+        {
+            table[c >> 6] |= uint64_t{1} << (c & 63);
+        }
+    }
+
+    std::size_t find(std::string_view text) const noexcept
     {
-        if (ch == delimiter)
+        for (std::size_t i = 0; i < text.size(); ++i)
         {
-            if (!current.empty() || !skipEmpty)
+            const auto c = static_cast<unsigned char>(text[i]);
+            if ((table[c >> 6] >> (c & 63)) & 1)
             {
-                parts.push_back(current);
+                return i;
             }
-            current.clear();
         }
-        else
+        return text.size();
+    }
+};
+} // namespace detail
+
+/**
+ * @brief Lazy range of the tokens between delimiters, as views into the input.
+ *
+ * Nothing is allocated, so the input must outlive the range and its tokens. Iterators carry
+ * their own copy of the delimiter and stay valid after the range object is gone.
+ */
+template <typename Delimiter>
+class TokenRange : public std::ranges::view_interface<TokenRange<Delimiter>>
+{
+public:
+    class iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const std::string_view *;
+        using reference = std::string_view;
+
+        iterator() = default;
+        iterator(std::string_view input, Delimiter delimiter, bool skipEmpty)
+            : m_rest(input), m_delimiter(delimiter), m_skipEmpty(skipEmpty), m_pending(true), m_done(false)
+        {
+            advance();
+        }
+
+        std::string_view operator*() const noexcept { return m_token; }
+        pointer operator->() const noexcept { return &m_token; }
+
+        iterator &operator++()
+        {
+            advance();
+            return *this;
+        }
+
+        iterator operator++(int)
+        {
+            auto copy = *this;
+            advance();
+            return copy;
+        }
+
+        friend bool operator==(const iterator &lhs, const iterator &rhs) noexcept
+        {
+            return lhs.m_done == rhs.m_done && (lhs.m_done || lhs.m_token.data() == rhs.m_token.data());
+        }
+
+    private:
+        void advance()
         {
-            current.push_back(ch);
+            while (m_pending)
+            {
+                const auto at = m_delimiter.find(m_rest);
+                m_token = m_rest.substr(0, at);
+                if (at == m_rest.size())
+                {
+                    m_pending = false;
+                    m_rest = {};
+                }
+                else
+                {
+                    m_rest.remove_prefix(at + 1);
+                }
+                if (!m_token.empty() || !m_skipEmpty)
+                {
+                    return;
+                }
+            }
+            m_done = true;
         }
+
+        std::string_view m_rest;
+        std::string_view m_token;
+        Delimiter m_delimiter{};
+        bool m_skipEmpty = true;
+        /// Text remains to be tokenised (possibly a final empty token after a delimiter).
+        bool m_pending = false;
+        bool m_done = true;
+    };
+
+    TokenRange(std::string_view input, Delimiter delimiter, bool skipEmpty)
+        : m_input(input), m_delimiter(delimiter), m_skipEmpty(skipEmpty)
+    {
     }
-    if (!current.empty() || !skipEmpty)
+
+    iterator begin() const { return iterator(m_input, m_delimiter, m_skipEmpty); }
+    iterator end() const noexcept { return iterator(); }
+
+private:
+    std::string_view m_input;
+    Delimiter m_delimiter;
+    bool m_skipEmpty;
+};
+
+/// @brief Tokens of input separated by delimiter, without allocating (see TokenRange).
+inline TokenRange<detail::CharDelimiter> tokens(std::string_view input, char delimiter, bool skipEmpty = true)
+{
+    return {input, detail::CharDelimiter{delimiter}, skipEmpty};
+}
+
+/// @brief Tokens of input separated by any of the characters in delimiters.
+inline TokenRange<detail::AnyOfDelimiters> tokens(std::string_view input,
+                                                  std::string_view delimiters,
+                                                  bool skipEmpty = true)
+{
+    return {input, detail::AnyOfDelimiters(delimiters), skipEmpty};
+}
+
+inline std::vector<std::string> split(std::string_view input, char delimiter, bool skipEmpty = true)
+{
+    std::vector<std::string> parts;
+    for (const auto token : tokens(input, delimiter, skipEmpty))
     {
-        parts.push_back(current);
+        parts.emplace_back(token);
     }
     return parts;
 }
@@ -82,6 +221,20 @@ inline bool ends_with(std::string_view input, std::string_view suffix)
     return input.size() >= suffix.size() && input.substr(input.size() - suffix.size()) == suffix;
 }
 
+/// @brief The whole token as a number; throws if any of it is not part of the number.
+template <typename T = int64_t>
+T parse_number(std::string_view token)
+{
+    T value{};
+    const char *end = token.data() + token.size();
+    const auto [ptr, ec] = std::from_chars(token.data(), end, value);
+    if (ec != std::errc{} || ptr != end)
+    {
+        throw std::runtime_error("Failed to convert token to number");
+    }
+    return value;
+}
+
 template <typename T = int64_t, typename Range>
 std::vector<T> to_numbers(const Range &range)
 {
@@ -89,15 +242,7 @@ std::vector<T> to_numbers(const Range &range)
     numbers.reserve(std::size(range));
     for (const auto &token : range)
     {
-        T value{};
-        const char *begin = token.data();
-        const char *end = begin + token.size();
-        const auto [ptr, ec] = std::from_chars(begin, end, value);
-        if (ec != std::errc{} || ptr != end)
-        {
-            throw std::runtime_error("Failed to convert token to number");
-        }
-        numbers.push_back(value);
+        numbers.push_back(parse_number<T>(token));
     }
     return numbers;
 }
@@ -107,19 +252,16 @@ std::vector<T> to_vector_of_numbers(std::string_view input, std::optional<char>
 {
     if (delimiter.has_value())
     {
-        auto tokens = split(input, *delimiter, true);
-        std::vector<std::string> cleaned;
-        cleaned.reserve(tokens.size());
-        for (auto &token : tokens)
+        std::vector<T> numbers;
+        for (const auto token : tokens(input, *delimiter))
         {
-            auto trimmed = trim_copy(token);
-            if (trimmed.empty())
+            const auto trimmed = trim_view(token);
+            if (!trimmed.empty())
             {
-                continue;
+                numbers.push_back(parse_number<T>(trimmed));
             }
-            cleaned.push_back(std::move(trimmed));
         }
-        return to_numbers<T>(cleaned);
+        return numbers;
     }
 
     std::vector<T> numbers;
@@ -1,13 +1,24 @@
 #include "TestHarness.hpp"
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include <algorithm>
+#include <cerrno>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
 #include <iterator>
 #include <mutex>
 #include <optional>
+#include <sstream>
 #include <stdexcept>
 
+#include "Bench.hpp"
+#include "Parallel.hpp"
+
 namespace common::tests
 {
 namespace
@@ -18,6 +29,10 @@ std::optional<DayTestSuite> g_cachedSuite;
 bool g_part1Enabled = true;
 bool g_part2Enabled = true;
 const std::vector<PartTestCase> g_disabledCases;
+/// Smaller inputs are read instead: a mapping costs more syscalls than reading a few pages.
+constexpr std::size_t kMapThreshold = 64 * 1024;
+/// Upper bound on solver pairs tried while shrinking one failure.
+constexpr std::size_t kMaxShrinkAttempts = 5000;
 
 std::string_view partFolder(Part part)
 {
@@ -33,39 +48,126 @@ std::string normalizeNewlines(std::string value)
     return value;
 }
 
-std::vector<PartTestCase> loadPartCases(const std::filesystem::path &root, Part part)
+/// Sample inputs in one part's folder, ordered by case name so discovery is deterministic.
+std::vector<std::filesystem::path> listCaseInputs(const std::filesystem::path &root, Part part)
 {
-    std::vector<PartTestCase> cases;
+    std::vector<std::filesystem::path> inputs;
     const auto partDir = root / partFolder(part);
     if (!std::filesystem::exists(partDir))
     {
-        return cases;
+        return inputs;
     }
 
     for (const auto &entry : std::filesystem::directory_iterator(partDir))
     {
-        if (!entry.is_regular_file() || entry.path().extension() != ".input")
+        if (entry.is_regular_file() && entry.path().extension() == ".input")
         {
-            continue;
+            inputs.push_back(entry.path());
         }
+    }
+    std::sort(inputs.begin(), inputs.end(), [](const auto &lhs, const auto &rhs) {
+        return lhs.stem().string() < rhs.stem().string();
+    });
+    return inputs;
+}
 
-        PartTestCase testCase;
-        testCase.name = entry.path().stem().string();
-        testCase.input = readLines(entry.path());
-        auto expectedPath = entry.path();
-        expectedPath.replace_extension(".expected");
-        if (std::filesystem::exists(expectedPath))
-        {
-            testCase.expected = normalizeNewlines(readText(expectedPath));
-        }
-        cases.emplace_back(std::move(testCase));
+PartTestCase discoverCase(const std::filesystem::path &inputPath)
+{
+    PartTestCase testCase;
+    testCase.name = inputPath.stem().string();
+    testCase.input = CaseInput::fromFile(inputPath);
+    auto expectedPath = inputPath;
+    expectedPath.replace_extension(".expected");
+    if (std::filesystem::exists(expectedPath))
+    {
+        testCase.expected = normalizeNewlines(readText(expectedPath));
     }
+    return testCase;
+}
 
-    std::sort(cases.begin(), cases.end(), [](const PartTestCase &lhs, const PartTestCase &rhs) {
-        return lhs.name < rhs.name;
-    });
 
-    return cases;
+/// Answers of both solvers on one input; nullopt reference means the input was rejected.
+struct Comparison
+{
+    std::optional<std::string> reference;
+    std::string candidate;
+    double referenceSeconds = 0.0;
+    double candidateSeconds = 0.0;
+
+    bool mismatch() const { return reference && *reference != candidate; }
+};
+
+Comparison compareSolvers(const SolverFn &reference, const SolverFn &candidate, const InputFile &input)
+{
+    Comparison result;
+    try
+    {
+        result.referenceSeconds = bench::timeSeconds([&] { result.reference = reference(input); });
+    }
+    catch (const std::exception &)
+    {
+        return result;
+    }
+    try
+    {
+        result.candidateSeconds = bench::timeSeconds([&] { result.candidate = candidate(input); });
+    }
+    catch (const std::exception &error)
+    {
+        result.candidate = std::string("exception: ") + error.what();
+    }
+    return result;
+}
+
+std::vector<std::string> generateLines(const gen::Generator &generator, const gen::Params &params, std::size_t maxLines)
+{
+    std::ostringstream text;
+    generator(text, params);
+    auto lines = InputFile::fromText(text.str()).getLines();
+    if (maxLines > 0 && lines.size() > maxLines)
+    {
+        lines.resize(maxLines);
+    }
+    return lines;
+}
+
+/// Delta debugging over lines: drop chunks that keep the solvers disagreeing, halving the
+/// chunk size whenever no chunk can go.
+DifferentialFailure shrink(DifferentialFailure failure, const SolverFn &reference, const SolverFn &candidate)
+{
+    std::size_t attempts = 0;
+    std::size_t chunk = std::max<std::size_t>(failure.input.size() / 2, 1);
+    while (attempts < kMaxShrinkAttempts)
+    {
+        bool removed = false;
+        for (std::size_t start = 0; start < failure.input.size() && attempts < kMaxShrinkAttempts; ++attempts)
+        {
+            auto trial = failure.input;
+            const auto end = std::min(start + chunk, trial.size());
+            trial.erase(trial.begin() + static_cast<std::ptrdiff_t>(start), trial.begin() + static_cast<std::ptrdiff_t>(end));
+            const auto outcome = compareSolvers(reference, candidate, InputFile::fromLines(trial));
+            if (outcome.mismatch())
+            {
+                failure.input = std::move(trial);
+                failure.reference = *outcome.reference;
+                failure.candidate = outcome.candidate;
+                removed = true;
+            }
+            else
+            {
+                start += chunk;
+            }
+        }
+        if (!removed)
+        {
+            if (chunk == 1)
+            {
+                break;
+            }
+            chunk /= 2;
+        }
+    }
+    return failure;
 }
 
 } // namespace
@@ -130,9 +232,24 @@ const std::vector<PartTestCase> &cases(Part which)
 
 DayTestSuite loadSuiteFrom(const std::filesystem::path &root)
 {
+    const auto part1Inputs = listCaseInputs(root, Part::One);
+    const auto part2Inputs = listCaseInputs(root, Part::Two);
+
+    // Every case has a fixed slot, so the order does not depend on which thread finishes first.
     DayTestSuite suite;
-    suite.part1 = loadPartCases(root, Part::One);
-    suite.part2 = loadPartCases(root, Part::Two);
+    suite.part1.resize(part1Inputs.size());
+    suite.part2.resize(part2Inputs.size());
+    parallel::parallelFor(part1Inputs.size() + part2Inputs.size(), [&](std::size_t i) {
+        if (i < part1Inputs.size())
+        {
+            suite.part1[i] = discoverCase(part1Inputs[i]);
+        }
+        else
+        {
+            const auto j = i - part1Inputs.size();
+            suite.part2[j] = discoverCase(part2Inputs[j]);
+        }
+    });
     return suite;
 }
 
@@ -186,7 +303,162 @@ std::filesystem::path resolveCasePath(const std::filesystem::path &root,
 
 InputFile makeInput(const PartTestCase &testCase)
 {
-    return InputFile::fromLines(testCase.input, testCase.name);
+    std::string_view text = testCase.inputText();
+    std::vector<std::string> lines;
+    lines.reserve(static_cast<std::size_t>(std::count(text.begin(), text.end(), '\n')) + 1);
+    while (!text.empty())
+    {
+        const auto newline = std::min(text.find('\n'), text.size());
+        auto line = text.substr(0, newline);
+        if (line.ends_with('\r'))
+        {
+            line.remove_suffix(1);
+        }
+        lines.emplace_back(line);
+        text.remove_prefix(std::min(newline + 1, text.size()));
+    }
+    return InputFile::fromLines(std::move(lines), testCase.name);
+}
+
+std::shared_ptr<const CaseInput> CaseInput::fromFile(std::filesystem::path path)
+{
+    std::shared_ptr<CaseInput> input(new CaseInput());
+    input->m_path = std::move(path);
+    return input;
+}
+
+std::shared_ptr<const CaseInput> CaseInput::fromText(std::string text)
+{
+    std::shared_ptr<CaseInput> input(new CaseInput());
+    input->m_owned = std::move(text);
+    std::call_once(input->m_loaded, [] {});
+    return input;
+}
+
+CaseInput::~CaseInput()
+{
+    if (m_mapping)
+    {
+        ::munmap(const_cast<char *>(m_mapping), m_mappedSize);
+    }
+}
+
+std::string_view CaseInput::text() const
+{
+    // A failed attempt leaves the flag unset, so the next caller tries again.
+    std::call_once(m_loaded, [this] {
+        const int fd = ::open(m_path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+        {
+            throw std::runtime_error("Unable to open test input: " + m_path.string());
+        }
+        struct stat info{};
+        if (::fstat(fd, &info) != 0)
+        {
+            ::close(fd);
+            throw std::runtime_error("Error while reading test input: " + m_path.string());
+        }
+        const auto size = static_cast<std::size_t>(info.st_size);
+        if (size < kMapThreshold)
+        {
+            m_owned.resize(size);
+            std::size_t done = 0;
+            while (done < size)
+            {
+                const auto got = ::read(fd, m_owned.data() + done, size - done);
+                if (got < 0 && errno == EINTR)
+                {
+                    continue;
+                }
+                if (got <= 0)
+                {
+                    break;
+                }
+                done += static_cast<std::size_t>(got);
+            }
+            m_owned.resize(done);
+        }
+        else
+        {
+            void *mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapping == MAP_FAILED)
+            {
+                const std::string reason = std::strerror(errno);
+                ::close(fd);
+                throw std::runtime_error("Unable to map test input " + m_path.string() + ": " + reason);
+            }
+            m_mapping = static_cast<const char *>(mapping);
+            m_mappedSize = size;
+        }
+        ::close(fd);
+    });
+    return m_mapping ? std::string_view(m_mapping, m_mappedSize) : std::string_view(m_owned);
+}
+
+DifferentialReport runDifferential(const gen::Generator &generator,
+                                   const SolverFn &reference,
+                                   const SolverFn &candidate,
+                                   const DifferentialOptions &options)
+{
+    std::vector<Comparison> outcomes(options.cases);
+    parallel::parallelFor(options.cases, [&](std::size_t i) {
+        const auto lines = generateLines(generator, {options.scale, options.firstSeed + i}, options.maxLines);
+        outcomes[i] = compareSolvers(reference, candidate, InputFile::fromLines(lines));
+    });
+
+    DifferentialReport report;
+    report.cases = options.cases;
+    for (std::size_t i = 0; i < outcomes.size(); ++i)
+    {
+        const auto &outcome = outcomes[i];
+        if (!outcome.reference)
+        {
+            ++report.skipped;
+            continue;
+        }
+        report.referenceSeconds += outcome.referenceSeconds;
+        report.candidateSeconds += outcome.candidateSeconds;
+        if (!outcome.mismatch())
+        {
+            continue;
+        }
+        if (++report.mismatches == 1)
+        {
+            const auto seed = options.firstSeed + i;
+            DifferentialFailure failure{seed, generateLines(generator, {options.scale, seed}, options.maxLines),
+                                        *outcome.reference, outcome.candidate};
+            report.firstFailure = shrink(std::move(failure), reference, candidate);
+        }
+    }
+    return report;
+}
+
+std::string describe(const DifferentialReport &report)
+{
+    std::ostringstream out;
+    out << report.cases << " cases, " << report.mismatches << " mismatches, " << report.skipped
+        << " rejected by the reference; reference " << report.referenceSeconds << "s, candidate "
+        << report.candidateSeconds << "s (" << report.speedup() << "x)";
+    if (report.firstFailure)
+    {
+        const auto &failure = *report.firstFailure;
+        out << "\nFirst mismatch, seed " << failure.seed << ": reference " << failure.reference << ", candidate "
+            << failure.candidate << ", shrunk to " << failure.input.size() << " lines:";
+        for (const auto &line : failure.input)
+        {
+            out << '\n' << line;
+        }
+    }
+    return out.str();
+}
+
+int runDifferentialTests(std::string_view dayId, std::string_view sourcePath, int argc, char **argv)
+{
+    const RunOptions options = buildRunOptions(dayId, sourcePath, argc, argv);
+    setVerbose(options.verbose);
+    parallel::setThreadCount(options.threads);
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
 }
 
 } // namespace common::tests
@@ -2,14 +2,22 @@
 
 #include <cstdint>
 #include <filesystem>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <vector>
 
 #include <gtest/gtest.h>
 
+#include "Generator.hpp"
 #include "ResultAdapter.hpp"
 #include "InputFile.hpp"
+#include "Config.hpp"
+#include "SolverContext.hpp"
 
 namespace common::tests
 {
@@ -20,11 +28,41 @@ enum class Part : uint8_t
     Two = 2
 };
 
+/// @brief Bytes of one case input, loaded the first time its text is asked for. Large files
+/// are memory-mapped and unmapped with the last case sharing them; small files and in-memory
+/// text are held as a string.
+class CaseInput
+{
+public:
+    static std::shared_ptr<const CaseInput> fromFile(std::filesystem::path path);
+    static std::shared_ptr<const CaseInput> fromText(std::string text);
+
+    ~CaseInput();
+    CaseInput(const CaseInput &) = delete;
+    CaseInput &operator=(const CaseInput &) = delete;
+
+    /// @brief The whole input; throws std::runtime_error when the file cannot be read.
+    std::string_view text() const;
+
+private:
+    CaseInput() = default;
+
+    std::filesystem::path m_path;
+    mutable std::once_flag m_loaded;
+    mutable std::string m_owned;
+    mutable const char *m_mapping = nullptr;
+    mutable std::size_t m_mappedSize = 0;
+};
+
 struct PartTestCase
 {
     std::string name;
-    std::vector<std::string> input;
+    /// Shared by copies of the case, so passing cases by value does not copy the input.
+    std::shared_ptr<const CaseInput> input;
     std::string expected;
+
+    /// @brief The input text, loaded on first use; empty when the case has no input.
+    std::string_view inputText() const { return input ? input->text() : std::string_view(); }
 };
 
 struct DayTestSuite
@@ -41,6 +79,8 @@ bool isPartEnabled(Part which);
 const DayTestSuite &currentSuite();
 const std::vector<PartTestCase> &cases(Part which);
 
+/// @brief Discovers both parts' cases in parallel, sorted by name. Expected outputs are read
+/// here; inputs stay on disk until a case's text is first used.
 DayTestSuite loadSuiteFrom(const std::filesystem::path &root);
 
 std::vector<std::string> readLines(const std::filesystem::path &path);
@@ -51,13 +91,21 @@ std::filesystem::path resolveCasePath(const std::filesystem::path &root,
                                       const std::string &caseName,
                                       std::string_view extension);
 
+/// @brief Splits the case's text straight into the InputFile's lines (CRLF tolerated).
 InputFile makeInput(const PartTestCase &testCase);
 
+/// @brief Runs solver on the case's input and returns its answer as a string. A solver that
+/// takes a SolverContext gets a fresh one labelled with the case name.
+template <typename Solver>
+std::string run_part(const PartTestCase &testCase, Solver &&solver)
+{
+    return detail::invokeSolver(solver, makeInput(testCase), testCase.name);
+}
+
 template <typename Solver, typename Expected>
 void expect_part(PartTestCase testCase, Solver &&solver, Expected &&expectedOverride)
 {
-    auto input = makeInput(testCase);
-    const auto actual = detail::normalizeResult(solver(input));
+    const auto actual = run_part(testCase, solver);
     const auto expected = detail::normalizeResult(std::forward<Expected>(expectedOverride));
     EXPECT_EQ(actual, expected) << testCase.name;
 }
@@ -65,9 +113,88 @@ void expect_part(PartTestCase testCase, Solver &&solver, Expected &&expectedOver
 template <typename Solver>
 void expect_part(PartTestCase testCase, Solver &&solver)
 {
-    auto input = makeInput(testCase);
-    const auto actual = detail::normalizeResult(solver(input));
+    const auto actual = run_part(testCase, solver);
     EXPECT_EQ(actual, testCase.expected) << testCase.name;
 }
 
+struct DifferentialOptions
+{
+    /// Generated inputs to compare, with seeds firstSeed, firstSeed + 1, ...
+    std::size_t cases = 1000;
+    uint64_t firstSeed = 1;
+    unsigned scale = 1;
+    /// Keep only the first maxLines lines of each input (0 keeps them whole), so a slow
+    /// reference finishes thousands of cases.
+    std::size_t maxLines = 0;
+};
+
+struct DifferentialFailure
+{
+    uint64_t seed = 0;
+    /// The generated input after shrinking: no single chunk of lines can be removed without
+    /// the two solvers agreeing again.
+    std::vector<std::string> input;
+    std::string reference;
+    std::string candidate;
+};
+
+struct DifferentialReport
+{
+    std::size_t cases = 0;
+    std::size_t mismatches = 0;
+    /// Inputs the reference rejected by throwing; they are not compared.
+    std::size_t skipped = 0;
+    double referenceSeconds = 0.0;
+    double candidateSeconds = 0.0;
+    /// The mismatch with the lowest seed, shrunk.
+    std::optional<DifferentialFailure> firstFailure;
+
+    /// @brief Reference time over candidate time across the compared cases.
+    double speedup() const { return candidateSeconds > 0.0 ? referenceSeconds / candidateSeconds : 0.0; }
+};
+
+using SolverFn = std::function<std::string(const InputFile &)>;
+
+/**
+ * @brief Runs a reference solver and a candidate on generated inputs and compares answers.
+ *
+ * Cases run in parallel on the shared pool, and each solver is timed on every case. An
+ * exception from the candidate counts as a mismatch. The lowest-seed mismatch is shrunk by
+ * removing chunks of lines for as long as the solvers still disagree.
+ */
+DifferentialReport runDifferential(const gen::Generator &generator,
+                                   const SolverFn &reference,
+                                   const SolverFn &candidate,
+                                   const DifferentialOptions &options = {});
+
+/// @brief One line of counts and times, followed by the shrunk failure when there is one.
+std::string describe(const DifferentialReport &report);
+
+/// @brief GoogleTest check that candidate agrees with reference on every generated input.
+template <typename Reference, typename Candidate>
+void expect_equivalent(const gen::Generator &generator,
+                       Reference &&reference,
+                       Candidate &&candidate,
+                       const DifferentialOptions &options = {})
+{
+    const auto report = runDifferential(
+        generator,
+        [&](const InputFile &input) { return detail::invokeSolver(reference, input, "reference"); },
+        [&](const InputFile &input) { return detail::invokeSolver(candidate, input, "candidate"); },
+        options);
+    if (isVerbose())
+    {
+        std::cout << describe(report) << std::endl;
+    }
+    EXPECT_EQ(report.mismatches, 0u) << describe(report);
+    EXPECT_LT(report.skipped, report.cases) << "The reference rejected every generated input.";
+}
+
+/**
+ * @brief main() for a day's differential test binary. Differential tests are slow, so they
+ *        live in their own `day-N-differential` target rather than in the day binary.
+ *        Accepts the runner's flags (`--verbose` prints every report, `--threads=N`).
+ */
+int runDifferentialTests(std::string_view dayId, std::string_view sourcePath, int argc, char **argv);
+
 } // namespace common::tests
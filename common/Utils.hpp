@@ -3,11 +3,15 @@
 #include <string_view>
 #include <vector>
 
+#include "ExactMath.hpp"
+#include "Geometry.hpp"
+#include "Graph.hpp"
 #include "Grid.hpp"
 #include "MathUtils.hpp"
 #include "Search.hpp"
 #include "StringUtils.hpp"
 #include "BitsetUtils.hpp"
+#include "Parallel.hpp"
 
 inline std::vector<std::string> splitString(std::string_view input, const char delimiter)
 {
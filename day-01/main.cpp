@@ -32,20 +32,20 @@ void runSampleSuite(common::tests::Part part)
                 if (testCase.expected.empty())
                 {
                     auto inputFile = common::tests::makeInput(testCase);
-                    handlePart1(inputFile);
+                    day01::handlePart1(inputFile);
                     continue;
                 }
-                common::tests::expect_part(testCase, handlePart1);
+                common::tests::expect_part(testCase, day01::handlePart1);
         }
         else
         {
                 if (testCase.expected.empty())
                 {
                     auto inputFile = common::tests::makeInput(testCase);
-                    handlePart2(inputFile);
+                    day01::handlePart2(inputFile);
                     continue;
                 }
-                common::tests::expect_part(testCase, handlePart2);
+                common::tests::expect_part(testCase, day01::handlePart2);
         }
     }
 }
@@ -74,7 +74,7 @@ TEST(Day01Puzzle, Part1Answer)
         GTEST_SKIP() << "Part disabled by CLI flags.";
     }
     auto input = loadPuzzleInput();
-    EXPECT_EQ(handlePart1(input), 1052);
+    EXPECT_EQ(day01::handlePart1(input), 1052);
 }
 
 TEST(Day01Puzzle, Part2Answer)
@@ -84,10 +84,11 @@ TEST(Day01Puzzle, Part2Answer)
         GTEST_SKIP() << "Part disabled by CLI flags.";
     }
     auto input = loadPuzzleInput();
-    EXPECT_EQ(handlePart2(input), 6295);
+    EXPECT_EQ(day01::handlePart2(input), 6295);
 }
 
 int main(int argc, char **argv)
 {
-    return common::runDay(argc, argv, kDayId, kSourcePath, handlePart1, handlePart2);
+    return common::runDay(argc, argv, kDayId, kSourcePath, day01::handlePart1, day01::handlePart2,
+                           day01::generateInput);
 }
\ No newline at end of file
@@ -0,0 +1,26 @@
+/**
+ * Day-1 - Input generator
+ */
+#include "include.hpp"
+
+namespace day01
+{
+namespace
+{
+constexpr std::size_t kRotations = 4500;
+constexpr int64_t kMaxDistance = 999;
+} // namespace
+
+void generateInput(std::ostream &out, const common::gen::Params &params)
+{
+    common::gen::Random random(params.seed);
+    const auto count = common::gen::scaled(kRotations, params);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        // Mostly short turns like the real input, with the occasional multi-revolution spin.
+        const auto distance = random.chance(0.9) ? random.between(1, 99) : random.between(100, kMaxDistance);
+        out << (random.chance(0.5) ? 'L' : 'R') << distance << '\n';
+    }
+}
+
+} // namespace day01
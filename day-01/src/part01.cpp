@@ -6,8 +6,8 @@
 
 #include <cstdint>
 
-namespace detail = day01::detail;
-
+namespace day01
+{
 int64_t handlePart1(const InputFile &input)
 {
     int position = 50;
@@ -22,4 +22,6 @@ int64_t handlePart1(const InputFile &input)
     });
 
     return static_cast<int64_t>(zeroHits);
-}
\ No newline at end of file
+}
+
+} // namespace day01
\ No newline at end of file
@@ -6,8 +6,8 @@
 
 #include <cstdint>
 
-namespace detail = day01::detail;
-
+namespace day01
+{
 int64_t handlePart2(const InputFile &input)
 {
     int position = 50;
@@ -19,4 +19,6 @@ int64_t handlePart2(const InputFile &input)
     });
 
     return static_cast<int64_t>(zeroHits);
-}
\ No newline at end of file
+}
+
+} // namespace day01
\ No newline at end of file
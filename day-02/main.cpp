@@ -30,20 +30,20 @@ void runSampleSuite(common::tests::Part part)
             if (testCase.expected.empty())
             {
                 auto inputFile = common::tests::makeInput(testCase);
-                handlePart1(inputFile);
+                day02::handlePart1(inputFile);
                 continue;
             }
-            common::tests::expect_part(testCase, handlePart1);
+            common::tests::expect_part(testCase, day02::handlePart1);
         }
         else
         {
             if (testCase.expected.empty())
             {
                 auto inputFile = common::tests::makeInput(testCase);
-                handlePart2(inputFile);
+                day02::handlePart2(inputFile);
                 continue;
             }
-            common::tests::expect_part(testCase, handlePart2);
+            common::tests::expect_part(testCase, day02::handlePart2);
         }
     }
 }
@@ -61,5 +61,6 @@ TEST(Day02Part2Samples, ValidateExamples)
 
 int main(int argc, char **argv)
 {
-    return common::runDay(argc, argv, kDayId, kSourcePath, handlePart1, handlePart2);
+    return common::runDay(argc, argv, kDayId, kSourcePath, day02::handlePart1, day02::handlePart2,
+                           day02::generateInput);
 }
\ No newline at end of file
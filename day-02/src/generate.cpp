@@ -0,0 +1,39 @@
+/**
+ * Day-2 - Input generator
+ */
+#include "include.hpp"
+
+#include <algorithm>
+
+namespace day02
+{
+namespace
+{
+constexpr std::size_t kRanges = 36;
+constexpr int kMaxDigits = 10;
+constexpr int64_t kMaxWidth = 100'000;
+} // namespace
+
+void generateInput(std::ostream &out, const common::gen::Params &params)
+{
+    common::gen::Random random(params.seed);
+    const auto count = common::gen::scaled(kRanges, params);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        // Ids of every length up to ten digits; the solvers walk each range id by id, so the
+        // width is what costs time.
+        const auto digits = static_cast<int>(random.between(1, kMaxDigits));
+        int64_t low = 1;
+        for (int d = 1; d < digits; ++d)
+        {
+            low *= 10;
+        }
+        const int64_t high = low * 10 - 1;
+        const auto first = random.between(low, high);
+        const auto last = std::min(high, first + random.between(0, std::min(kMaxWidth, low)));
+        out << (i == 0 ? "" : ",") << first << '-' << last;
+    }
+    out << '\n';
+}
+
+} // namespace day02
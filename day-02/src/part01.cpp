@@ -7,6 +7,8 @@
 
 using namespace std::ranges;
 
+namespace day02
+{
 int64_t handlePart1(const InputFile &input) {
     const auto &inputLines = input.getLines();
 
@@ -17,7 +19,6 @@ int64_t handlePart1(const InputFile &input) {
     }
 
     auto numbers = splitString(inputLines[0], ',');
-    std::cout << "Testing" << std::endl;
 
     uint64_t total = 0;
 
@@ -42,6 +43,7 @@ int64_t handlePart1(const InputFile &input) {
         }
     }
 
-
     return total;
-}
\ No newline at end of file
+}
+
+} // namespace day02
\ No newline at end of file
@@ -7,6 +7,8 @@
 
 using namespace std::ranges;
 
+namespace day02
+{
 int64_t handlePart2(const InputFile &input) {
     const auto &inputLines = input.getLines();
         // Should only have a single line 
@@ -16,7 +18,6 @@ int64_t handlePart2(const InputFile &input) {
     }
 
     auto numbers = splitString(inputLines[0], ',');
-    std::cout << "Testing" << std::endl;
 
     uint64_t total = 0;
 
@@ -29,7 +30,6 @@ int64_t handlePart2(const InputFile &input) {
         {
             const auto strnum = std::to_string(curr);
 
-
             // We want to split up the string into substring on varying length, up to half the length.
             for(const auto len : iota_view{1, (int)((strnum.length()/2)+1)})
             {
@@ -64,6 +64,7 @@ int64_t handlePart2(const InputFile &input) {
         }
     }
 
-
     return total;
-}
\ No newline at end of file
+}
+
+} // namespace day02
\ No newline at end of file
@@ -0,0 +1,29 @@
+/**
+ * Day-3 - Input generator
+ */
+#include "include.hpp"
+
+namespace day03
+{
+namespace
+{
+constexpr std::size_t kBanks = 200;
+constexpr std::size_t kBatteriesPerBank = 100;
+} // namespace
+
+void generateInput(std::ostream &out, const common::gen::Params &params)
+{
+    common::gen::Random random(params.seed);
+    const auto count = common::gen::scaled(kBanks, params);
+    std::string bank(kBatteriesPerBank, '1');
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        for (auto &battery : bank)
+        {
+            battery = static_cast<char>('0' + random.between(1, 9));
+        }
+        out << bank << '\n';
+    }
+}
+
+} // namespace day03
@@ -8,8 +8,16 @@
 #include <string_view>
 #include <vector>
 
+#include "Generator.hpp"
 #include "InputFile.hpp"
 #include "Utils.hpp"
 
+namespace day03
+{
 int64_t handlePart1(const InputFile &input);
-int64_t handlePart2(const InputFile &input);
\ No newline at end of file
+int64_t handlePart2(const InputFile &input);
+
+/// @brief Writes a synthetic input of battery banks; see generate.cpp for what the scale multiplies.
+void generateInput(std::ostream &out, const common::gen::Params &params);
+
+} // namespace day03
\ No newline at end of file
@@ -6,6 +6,8 @@
 #include <vector>
 #include <iostream>
 
+namespace day03
+{
 int64_t handlePart1(const InputFile &input) {
 
     uint64_t total = 0;
@@ -18,4 +20,6 @@ int64_t handlePart1(const InputFile &input) {
     }
 
     return total;
-}
\ No newline at end of file
+}
+
+} // namespace day03
\ No newline at end of file
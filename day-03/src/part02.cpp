@@ -4,6 +4,8 @@
 #include "include.hpp"
 #include <array>
 
+namespace day03
+{
 int64_t handlePart2(const InputFile &input) 
 {
     constexpr std::size_t NUM_DIGITS = 12;
@@ -31,4 +33,6 @@ int64_t handlePart2(const InputFile &input)
     }
 
     return total;
-}
\ No newline at end of file
+}
+
+} // namespace day03
\ No newline at end of file
@@ -31,20 +31,20 @@ void runSampleSuite(common::tests::Part part)
             if (testCase.expected.empty())
             {
                 auto inputFile = common::tests::makeInput(testCase);
-                handlePart1(inputFile);
+                day04::handlePart1(inputFile);
                 continue;
             }
-            common::tests::expect_part(testCase, handlePart1);
+            common::tests::expect_part(testCase, day04::handlePart1);
         }
         else
         {
             if (testCase.expected.empty())
             {
                 auto inputFile = common::tests::makeInput(testCase);
-                handlePart2(inputFile);
+                day04::handlePart2(inputFile);
                 continue;
             }
-            common::tests::expect_part(testCase, handlePart2);
+            common::tests::expect_part(testCase, day04::handlePart2);
         }
     }
 }
@@ -62,5 +62,6 @@ TEST(Day4Part2Samples, ValidateExamples)
 
 int main(int argc, char **argv)
 {
-    return common::runDay(argc, argv, kDayId, kSourcePath, handlePart1, handlePart2);
+    return common::runDay(argc, argv, kDayId, kSourcePath, day04::handlePart1, day04::handlePart2,
+                           day04::generateInput);
 }
\ No newline at end of file
@@ -0,0 +1,30 @@
+/**
+ * Day-4 - Input generator
+ */
+#include "include.hpp"
+
+namespace day04
+{
+namespace
+{
+constexpr std::size_t kSide = 135;
+constexpr double kRollDensity = 0.6;
+} // namespace
+
+void generateInput(std::ostream &out, const common::gen::Params &params)
+{
+    common::gen::Random random(params.seed);
+    // The grid grows in both directions, so scale multiplies the cell count.
+    const auto side = common::gen::scaledSide(kSide, params);
+    std::string row(side, '.');
+    for (std::size_t y = 0; y < side; ++y)
+    {
+        for (auto &cell : row)
+        {
+            cell = random.chance(kRollDensity) ? '@' : '.';
+        }
+        out << row << '\n';
+    }
+}
+
+} // namespace day04
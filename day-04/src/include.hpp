@@ -8,8 +8,16 @@
 #include <string_view>
 #include <vector>
 
+#include "Generator.hpp"
 #include "InputFile.hpp"
 #include "Utils.hpp"
 
+namespace day04
+{
 int64_t handlePart1(const InputFile &input);
-int64_t handlePart2(const InputFile &input);
\ No newline at end of file
+int64_t handlePart2(const InputFile &input);
+
+/// @brief Writes a synthetic input of a grid of paper rolls; see generate.cpp for what the scale multiplies.
+void generateInput(std::ostream &out, const common::gen::Params &params);
+
+} // namespace day04
\ No newline at end of file
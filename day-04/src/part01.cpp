@@ -3,6 +3,8 @@
  */
 #include "include.hpp"
 
+namespace day04
+{
 int64_t handlePart1(const InputFile &input) {
     const auto& map = input.asGrid();
     uint32_t total = 0;
@@ -16,7 +18,6 @@ int64_t handlePart1(const InputFile &input) {
 
         const auto& neighbours = map.allNeighbors(coord);
 
-
         uint32_t count = 0;
         for(const auto& cell : neighbours)
         {
@@ -32,4 +33,6 @@ int64_t handlePart1(const InputFile &input) {
         
     }
     return total;
-}
\ No newline at end of file
+}
+
+} // namespace day04
\ No newline at end of file
@@ -3,6 +3,8 @@
  */
 #include "include.hpp"
 
+namespace day04
+{
 int64_t handlePart2(const InputFile &input)
 {
     auto map = input.asGrid();
@@ -44,4 +46,6 @@ int64_t handlePart2(const InputFile &input)
     } while (hadChanges); // Keep removing rolls until we can't remove anymore
 
     return totalRemoved;
-}
\ No newline at end of file
+}
+
+} // namespace day04
\ No newline at end of file
@@ -0,0 +1,51 @@
+/**
+ * Day-5 - Input generator
+ */
+#include "include.hpp"
+
+#include <utility>
+#include <vector>
+
+namespace day05
+{
+namespace
+{
+constexpr std::size_t kRanges = 180;
+constexpr std::size_t kIds = 1000;
+constexpr int64_t kIdSpan = 500'000'000'000'000;
+} // namespace
+
+void generateInput(std::ostream &out, const common::gen::Params &params)
+{
+    common::gen::Random random(params.seed);
+    const auto rangeCount = common::gen::scaled(kRanges, params);
+    // Ranges average four times the gap between starts, so many overlap and merging matters.
+    const int64_t maxWidth = 8 * (kIdSpan / static_cast<int64_t>(rangeCount));
+
+    std::vector<std::pair<int64_t, int64_t>> ranges;
+    ranges.reserve(rangeCount);
+    for (std::size_t i = 0; i < rangeCount; ++i)
+    {
+        const auto first = random.between(1, kIdSpan);
+        ranges.emplace_back(first, first + random.between(0, maxWidth));
+        out << ranges.back().first << '-' << ranges.back().second << '\n';
+    }
+    out << '\n';
+
+    const auto idCount = common::gen::scaled(kIds, params);
+    for (std::size_t i = 0; i < idCount; ++i)
+    {
+        // About half the ids are drawn from a range so both answers are non-trivial.
+        if (random.chance(0.5))
+        {
+            const auto &[first, last] = random.pick(ranges);
+            out << random.between(first, last) << '\n';
+        }
+        else
+        {
+            out << random.between(1, kIdSpan + maxWidth) << '\n';
+        }
+    }
+}
+
+} // namespace day05
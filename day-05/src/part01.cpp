@@ -7,9 +7,10 @@
 #include <algorithm>
 #include <cstring>
 
-
 using namespace std::ranges;
 
+namespace day05
+{
 int64_t handlePart1(const InputFile &input) {
     const auto &lines = input.getLines();
     
@@ -40,4 +41,6 @@ int64_t handlePart1(const InputFile &input) {
     }
 
     return total;
-}
\ No newline at end of file
+}
+
+} // namespace day05
\ No newline at end of file
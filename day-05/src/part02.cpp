@@ -6,6 +6,8 @@
 #include <vector>
 #include <cstring>
 
+namespace day05
+{
 int64_t handlePart2(const InputFile &input) {
     const auto &lines = input.getLines();
     
@@ -57,4 +59,6 @@ int64_t handlePart2(const InputFile &input) {
     }
     
     return totalCount;
-}
\ No newline at end of file
+}
+
+} // namespace day05
\ No newline at end of file
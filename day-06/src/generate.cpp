@@ -0,0 +1,52 @@
+/**
+ * Day-6 - Input generator
+ */
+#include "include.hpp"
+
+#include <algorithm>
+#include <array>
+
+namespace day06
+{
+namespace
+{
+constexpr std::size_t kProblems = 1000;
+constexpr std::size_t kRows = 4;
+/// Powers of ten bounding numbers of 1 to 4 digits.
+constexpr std::array<int64_t, 5> kPowers{1, 10, 100, 1000, 10000};
+} // namespace
+
+void generateInput(std::ostream &out, const common::gen::Params &params)
+{
+    common::gen::Random random(params.seed);
+    const auto count = common::gen::scaled(kProblems, params);
+
+    // Each problem is a block of columns as wide as its longest number, with its numbers all
+    // aligned left or all aligned right; a blank column separates neighbouring problems.
+    std::array<std::string, kRows + 1> lines;
+    for (std::size_t p = 0; p < count; ++p)
+    {
+        std::array<std::string, kRows> numbers;
+        std::size_t width = 0;
+        for (auto &number : numbers)
+        {
+            const auto digits = static_cast<std::size_t>(random.between(1, kPowers.size() - 1));
+            number = std::to_string(random.between(kPowers[digits - 1], kPowers[digits] - 1));
+            width = std::max(width, number.size());
+        }
+        const bool alignLeft = random.chance(0.5);
+        for (std::size_t r = 0; r < kRows; ++r)
+        {
+            const std::string padding(width - numbers[r].size(), ' ');
+            lines[r] += (p == 0 ? "" : " ") + (alignLeft ? numbers[r] + padding : padding + numbers[r]);
+        }
+        lines[kRows] += (p == 0 ? "" : " ") + std::string(1, random.chance(0.5) ? '+' : '*') +
+                        std::string(width - 1, ' ');
+    }
+    for (const auto &line : lines)
+    {
+        out << line << '\n';
+    }
+}
+
+} // namespace day06
@@ -5,6 +5,8 @@
 #include <ranges>
 using namespace std::ranges;
 
+namespace day06
+{
 enum class Operation
 {
     ADD,
@@ -61,4 +63,6 @@ int64_t handlePart1(const InputFile &input) {
         }
     }
     return total;
-}
\ No newline at end of file
+}
+
+} // namespace day06
\ No newline at end of file
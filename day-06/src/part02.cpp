@@ -5,6 +5,8 @@
 #include <ranges>
 using namespace std::ranges;
 
+namespace day06
+{
 enum class Operation
 {
     ADD,
@@ -31,7 +33,6 @@ int64_t handlePart2(const InputFile &input) {
     auto ops = lines[lines.size()-1] | views::filter([](const auto& character){return character != ' ';});
     probs.resize(std::ranges::distance(ops));
 
-
     
     // Add all of the numbers, which is all lines other than the last, which is the ops.
     for( const auto idx : views::iota(size_t(0), lines[0].size()) | views::reverse)
@@ -75,4 +76,6 @@ int64_t handlePart2(const InputFile &input) {
         }
     }
     return total;
-}
\ No newline at end of file
+}
+
+} // namespace day06
\ No newline at end of file
@@ -0,0 +1,50 @@
+/**
+ * Day-7 - Input generator
+ */
+#include "include.hpp"
+
+#include <algorithm>
+
+namespace day07
+{
+namespace
+{
+constexpr std::size_t kSide = 141;
+constexpr double kSplitterDensity = 0.7;
+} // namespace
+
+void generateInput(std::ostream &out, const common::gen::Params &params)
+{
+    common::gen::Random random(params.seed);
+    // Odd width so the source sits in the middle column; scale multiplies the cell count.
+    const auto width = common::gen::scaledSide(kSide, params) | 1;
+    const auto source = static_cast<int64_t>(width / 2);
+    // Timelines roughly double at every splitter a beam meets, so splitters thin out as the
+    // grid grows; otherwise part 2 overflows 64 bits beyond the real input's size.
+    const double density = kSplitterDensity * std::min(1.0, static_cast<double>(kSide) / static_cast<double>(width));
+
+    std::string row(width, '.');
+    row[static_cast<std::size_t>(source)] = 'S';
+    out << row << '\n';
+    row[static_cast<std::size_t>(source)] = '.';
+    for (std::size_t y = 1; y < width; ++y)
+    {
+        std::fill(row.begin(), row.end(), '.');
+        if (y % 2 == 0)
+        {
+            // Splitters sit on every other row inside the cone the beams can reach, on
+            // alternating columns, so two are never side by side.
+            const auto reach = static_cast<int64_t>(y / 2) - 1;
+            for (int64_t x = source - reach; x <= source + reach; x += 2)
+            {
+                if (x >= 0 && x < static_cast<int64_t>(width) && random.chance(density))
+                {
+                    row[static_cast<std::size_t>(x)] = '^';
+                }
+            }
+        }
+        out << row << '\n';
+    }
+}
+
+} // namespace day07
@@ -6,6 +6,8 @@
 
 using namespace std::ranges;
 
+namespace day07
+{
 int64_t handlePart1(const InputFile &input)
 {
     auto grid = input.asGrid();
@@ -44,4 +46,6 @@ int64_t handlePart1(const InputFile &input)
     }
 
     return splits;
-}
\ No newline at end of file
+}
+
+} // namespace day07
\ No newline at end of file
@@ -6,6 +6,8 @@
 
 using namespace std::ranges;
 
+namespace day07
+{
 int64_t handlePart2(const InputFile &input)
 {
     const auto &grid = input.asGrid();
@@ -72,4 +74,6 @@ int64_t handlePart2(const InputFile &input)
     }
 
     return totalTimelines;
-}
\ No newline at end of file
+}
+
+} // namespace day07
\ No newline at end of file
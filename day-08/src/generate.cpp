@@ -0,0 +1,26 @@
+/**
+ * Day-8 - Input generator
+ */
+#include "include.hpp"
+
+namespace day08
+{
+namespace
+{
+constexpr std::size_t kBoxes = 1000;
+constexpr int64_t kMaxCoordinate = 99'999;
+} // namespace
+
+void generateInput(std::ostream &out, const common::gen::Params &params)
+{
+    common::gen::Random random(params.seed);
+    // The space stays the same size, so boxes get denser as the scale grows.
+    const auto count = common::gen::scaled(kBoxes, params);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        out << random.between(0, kMaxCoordinate) << ',' << random.between(0, kMaxCoordinate) << ','
+            << random.between(0, kMaxCoordinate) << '\n';
+    }
+}
+
+} // namespace day08
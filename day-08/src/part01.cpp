@@ -6,9 +6,12 @@
 #include <iostream>
 #include <cmath>
 #include <map>
+#include <algorithm>
 
 using namespace std::ranges;
 
+namespace day08
+{
 struct BoxPosition
 {
     int64_t x;
@@ -19,6 +22,9 @@ struct BoxPosition
 using BoxPair = std::pair<uint32_t, uint32_t>;
 using BoxPairAndDist = std::pair<BoxPair, uint64_t>;
 
+constexpr std::size_t kExampleBoxes = 20;
+constexpr std::size_t kExamplePairs = 10;
+
 static inline uint64_t distance(BoxPosition pos1, BoxPosition pos2)
 {
     return static_cast<uint64_t>(std::pow(double(pos2.x - pos1.x), 2) + std::pow(double(pos2.y - pos1.y), 2) + std::pow(double(pos2.z - pos1.z), 2));
@@ -89,7 +95,10 @@ int64_t handlePart1(const InputFile &input)
     // Find all of the pairs and their distances between each other. Data is returned sorted, lowest to highest distance.
     auto data = findAndSortDistances(boxes);
 
-    const auto numIters = (boxes.size() == 1000) ? 1000 : 10; // only do 10 iters for sample, else do the full 1000.
+    // The puzzle joins 1000 pairs for its 1000 boxes but only 10 for the 20-box example. Join
+    // one pair per box for anything bigger than the example so larger inputs scale the same way.
+    const std::size_t numIters =
+        std::min(data.size(), boxes.size() <= kExampleBoxes ? kExamplePairs : boxes.size());
 
     std::vector<uint32_t> parents;
     std::vector<uint32_t> sizes;
@@ -101,7 +110,7 @@ int64_t handlePart1(const InputFile &input)
     }
 
     // Proccess the amount of iterations to get them into sets.
-    for (uint32_t idx = 0; idx < numIters; idx++)
+    for (std::size_t idx = 0; idx < numIters; idx++)
     {
         unionBoxes(parents, sizes, data[idx].first.first, data[idx].first.second);
     }
@@ -120,4 +129,6 @@ int64_t handlePart1(const InputFile &input)
     std::ranges::sort(vec, greater{}, &std::pair<uint32_t, uint32_t>::second);
 
     return vec[0].second * vec[1].second * vec[2].second;
-}
\ No newline at end of file
+}
+
+} // namespace day08
\ No newline at end of file
@@ -9,6 +9,8 @@
 
 using namespace std::ranges;
 
+namespace day08
+{
 struct BoxPosition
 {
     int64_t x;
@@ -91,8 +93,6 @@ int64_t handlePart2(const InputFile &input)
     // Find all of the pairs and their distances between each other. Data is returned sorted, lowest to highest distance.
     auto data = findAndSortDistances(boxes);
 
-    const auto numIters = (boxes.size() == 1000) ? 1000 : 10; // only do 10 iters for sample, else do the full 1000.
-
     std::vector<uint32_t> parents;
     std::vector<uint32_t> sizes;
 
@@ -115,4 +115,6 @@ int64_t handlePart2(const InputFile &input)
         }
     }
     return 0; // Shouldnt get here.
-}
\ No newline at end of file
+}
+
+} // namespace day08
\ No newline at end of file
@@ -0,0 +1,70 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string_view>
+#include <vector>
+
+#include "Geometry.hpp"
+#include "TestHarness.hpp"
+#include "src/include.hpp"
+
+namespace {
+constexpr std::string_view kDayId = "09";
+constexpr std::string_view kSourcePath = __FILE__;
+}
+
+TEST(Day9Differential, Part1MatchesAllPairs)
+{
+    common::tests::expect_equivalent(day09::generateInput, day09::handlePart1Reference, day09::handlePart1,
+                                     {.cases = 200});
+}
+
+TEST(Day9Differential, Part2MatchesLinearEdgeScan)
+{
+    common::tests::expect_equivalent(day09::generateInput, day09::handlePart2Reference, day09::handlePart2,
+                                     {.cases = 100, .maxLines = 120});
+}
+
+// Enough points and rejections that the rectangle search runs many batches, against a
+// plain scan of every pair.
+TEST(Day9Differential, RectangleSearchMatchesAllPairsAcrossBatches)
+{
+    using common::geometry::Point;
+    std::mt19937 rng(9);
+    std::uniform_int_distribution<int64_t> coordinate(0, 1'000'000);
+    std::vector<Point> points(3000);
+    for (auto &point : points)
+    {
+        point = {coordinate(rng), coordinate(rng)};
+    }
+    const uint64_t limit = 100'000'000'000;
+    const auto accept = [limit](const Point &a, const Point &b) {
+        const uint64_t mix = static_cast<uint64_t>(a.x * 31 + a.y) ^ static_cast<uint64_t>(b.x * 31 + b.y);
+        return common::geometry::rectangleArea(a, b) <= limit && mix % 7 == 0;
+    };
+
+    uint64_t expected = 0;
+    for (std::size_t i = 0; i < points.size(); ++i)
+    {
+        for (std::size_t j = i + 1; j < points.size(); ++j)
+        {
+            if (accept(points[i], points[j]))
+            {
+                expected = std::max(expected, common::geometry::rectangleArea(points[i], points[j]));
+            }
+        }
+    }
+
+    common::geometry::RectangleSearchStats stats;
+    const auto found = common::geometry::largestRectangleWhere(points, accept, &stats);
+    ASSERT_TRUE(found.has_value());
+    EXPECT_EQ(*found, expected);
+    EXPECT_GT(stats.evaluated, 4 * points.size());
+}
+
+int main(int argc, char **argv)
+{
+    return common::tests::runDifferentialTests(kDayId, kSourcePath, argc, argv);
+}
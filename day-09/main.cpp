@@ -30,21 +30,19 @@ void runSampleSuite(common::tests::Part part)
         {
             if (testCase.expected.empty())
             {
-                auto inputFile = common::tests::makeInput(testCase);
-                handlePart1(inputFile);
+                common::tests::run_part(testCase, day09::handlePart1);
                 continue;
             }
-            common::tests::expect_part(testCase, handlePart1);
+            common::tests::expect_part(testCase, day09::handlePart1);
         }
         else
         {
             if (testCase.expected.empty())
             {
-                auto inputFile = common::tests::makeInput(testCase);
-                handlePart2(inputFile);
+                common::tests::run_part(testCase, day09::handlePart2);
                 continue;
             }
-            common::tests::expect_part(testCase, handlePart2);
+            common::tests::expect_part(testCase, day09::handlePart2);
         }
     }
 }
@@ -62,5 +60,6 @@ TEST(Day9Part2Samples, ValidateExamples)
 
 int main(int argc, char **argv)
 {
-    return common::runDay(argc, argv, kDayId, kSourcePath, handlePart1, handlePart2);
+    return common::runDay(argc, argv, kDayId, kSourcePath, day09::handlePart1, day09::handlePart2,
+                           day09::generateInput);
 }
\ No newline at end of file
@@ -0,0 +1,81 @@
+/**
+ * Day-9 - Input generator
+ */
+#include "include.hpp"
+
+#include <algorithm>
+#include <array>
+#include <utility>
+#include <vector>
+
+namespace day09
+{
+namespace
+{
+/// The real inputs have about 500 red tiles; each staircase step adds two.
+constexpr std::size_t kStepsPerQuadrant = 62;
+constexpr int64_t kRadius = 48'000;
+constexpr int64_t kMargin = 1'000;
+
+/// count distinct offsets in [1, radius], dealt at random into two ascending halves so the
+/// two quadrants sharing a half-axis never reuse a coordinate.
+std::pair<std::vector<int64_t>, std::vector<int64_t>> splitOffsets(common::gen::Random &random,
+                                                                   std::size_t count,
+                                                                   int64_t radius)
+{
+    auto values = random.distinct(2 * count, 1, radius);
+    random.shuffle(values);
+    std::vector<int64_t> first(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(count));
+    std::vector<int64_t> second(values.begin() + static_cast<std::ptrdiff_t>(count), values.end());
+    std::ranges::sort(first);
+    std::ranges::sort(second);
+    return {std::move(first), std::move(second)};
+}
+} // namespace
+
+void generateInput(std::ostream &out, const common::gen::Params &params)
+{
+    common::gen::Random random(params.seed);
+    const auto steps = common::gen::scaled(kStepsPerQuadrant, params);
+    const int64_t radius = std::max<int64_t>(kRadius, static_cast<int64_t>(4 * steps));
+    const int64_t centre = radius + kMargin;
+
+    // Offsets from the centre along each half-axis, shared by the two quadrants that touch it.
+    auto [east1, east4] = splitOffsets(random, steps, radius);
+    auto [west2, west3] = splitOffsets(random, steps, radius);
+    auto [north1, north2] = splitOffsets(random, steps, radius);
+    auto [south3, south4] = splitOffsets(random, steps, radius);
+
+    // Walking anticlockwise from the east, each quadrant is a monotone staircase: its points
+    // move towards the next half-axis in both coordinates. Chains in different quadrants
+    // cannot cross, so the polygon is simple.
+    std::vector<Coordinate> points;
+    points.reserve(4 * steps);
+    for (std::size_t i = 0; i < steps; ++i)
+    {
+        points.push_back({centre + east1[steps - 1 - i], centre + north1[i]});
+    }
+    for (std::size_t i = 0; i < steps; ++i)
+    {
+        points.push_back({centre - west2[i], centre + north2[steps - 1 - i]});
+    }
+    for (std::size_t i = 0; i < steps; ++i)
+    {
+        points.push_back({centre - west3[steps - 1 - i], centre - south3[i]});
+    }
+    for (std::size_t i = 0; i < steps; ++i)
+    {
+        points.push_back({centre + east4[i], centre - south4[steps - 1 - i]});
+    }
+
+    // Join consecutive points with a vertical then a horizontal edge. All coordinates on a
+    // half-axis are distinct, so every corner is a real turn.
+    for (std::size_t i = 0; i < points.size(); ++i)
+    {
+        const auto &point = points[i];
+        const auto &next = points[(i + 1) % points.size()];
+        out << point.x << ',' << point.y << '\n' << point.x << ',' << next.y << '\n';
+    }
+}
+
+} // namespace day09
@@ -8,8 +8,23 @@
 #include <string_view>
 #include <vector>
 
+#include "Generator.hpp"
 #include "InputFile.hpp"
+#include "SolverContext.hpp"
 #include "Utils.hpp"
 
-int64_t handlePart1(const InputFile &input);
-int64_t handlePart2(const InputFile &input);
\ No newline at end of file
+namespace day09
+{
+int64_t handlePart1(const InputFile &input, common::SolverContext &context);
+int64_t handlePart2(const InputFile &input, common::SolverContext &context);
+
+/// @brief Part 1 over every pair of tiles; the reference for differential tests.
+int64_t handlePart1Reference(const InputFile &input);
+
+/// @brief Part 2 with a linear edge scan over every pair of tiles; the reference for differential tests.
+int64_t handlePart2Reference(const InputFile &input);
+
+/// @brief Writes a synthetic input of red tiles forming a rectilinear polygon; see generate.cpp for what the scale multiplies.
+void generateInput(std::ostream &out, const common::gen::Params &params);
+
+} // namespace day09
\ No newline at end of file
@@ -2,12 +2,35 @@
  * Day-9 - Part 01
  */
 #include "include.hpp"
-#include <ranges>
-#include <iostream>
 
-using namespace std::ranges;
+#include <algorithm>
+#include <cstdlib>
 
-int64_t handlePart1(const InputFile &input)
+namespace day09
+{
+int64_t handlePart1(const InputFile &input, common::SolverContext &context)
+{
+    const auto &lines = input.getLines();
+
+    std::vector<Coordinate> tiles;
+
+    for (const auto &line : lines)
+    {
+        auto nums = common::str::to_vector_of_numbers(line, ',');
+        tiles.emplace_back(nums[0], nums[1]);
+    }
+
+    // Branch and bound over the staircase extremes; most pairs can never beat the best area.
+    common::geometry::RectangleSearchStats stats;
+    const auto maxArea = common::geometry::largestRectangle(tiles, &stats);
+
+    context.log() << context.label() << ": pairs evaluated: " << stats.evaluated << ", pruned: " << stats.pruned
+                  << " (of " << stats.totalPairs << ")" << std::endl;
+
+    return static_cast<int64_t>(maxArea);
+}
+
+int64_t handlePart1Reference(const InputFile &input)
 {
     const auto &lines = input.getLines();
 
@@ -20,14 +43,17 @@ int64_t handlePart1(const InputFile &input)
     }
 
     uint64_t maxArea = 0;
-    for (const auto [tile1Idx, tile1] : tiles | views::enumerate)
+    for (std::size_t i = 0; i < tiles.size(); ++i)
     {
-        for (const auto tile2 : tiles | views::drop(tile1Idx + 1))
+        for (std::size_t j = i + 1; j < tiles.size(); ++j)
         {
-            auto area = static_cast<uint64_t>(std::abs(tile1.x - tile2.x + 1) * std::abs(tile1.y - tile2.y + 1));
-            maxArea = std::max(area, maxArea);
+            const auto width = std::abs(tiles[i].x - tiles[j].x) + 1;
+            const auto height = std::abs(tiles[i].y - tiles[j].y) + 1;
+            maxArea = std::max(static_cast<uint64_t>(width * height), maxArea);
         }
     }
 
-    return maxArea;
-}
\ No newline at end of file
+    return static_cast<int64_t>(maxArea);
+}
+
+} // namespace day09
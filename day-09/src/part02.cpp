@@ -2,21 +2,12 @@
  * Day-9 - Part 02
  */
 #include "include.hpp"
-#include <ranges>
 #include <iostream>
 #include <unordered_set>
 #include <algorithm>
 
-using namespace std::ranges;
-
-// Store polygon edges for efficient rectangle checking
-struct Edge
+namespace day09
 {
-    Coordinate start;
-    Coordinate end;
-    bool isVertical;
-};
-
 // Check if a rectangle is fully inside the polygon using edge intersection
 // A rectangle is valid if:
 // 1. All 4 corners are inside the polygon
@@ -47,6 +38,16 @@ bool isPointInPolygon(const std::vector<Coordinate> &polygon, Coordinate point)
     return (crossings % 2) == 1;
 }
 
+namespace
+{
+// Store polygon edges for the reference's linear crossing scan
+struct Edge
+{
+    Coordinate start;
+    Coordinate end;
+    bool isVertical;
+};
+
 // Check if a vertical edge intersects the interior of a rectangle (not just touches boundary)
 bool verticalEdgeCrossesRect(int64_t edgeX, int64_t edgeY1, int64_t edgeY2,
                              int64_t rectMinX, int64_t rectMaxX, int64_t rectMinY, int64_t rectMaxY)
@@ -74,8 +75,70 @@ bool horizontalEdgeCrossesRect(int64_t edgeY, int64_t edgeX1, int64_t edgeX2,
     // Check if edge's x range overlaps with rectangle's interior x range
     return eMinX < rectMaxX && eMaxX > rectMinX;
 }
+} // namespace
 
-int64_t handlePart2(const InputFile &input)
+int64_t handlePart2(const InputFile &input, common::SolverContext &context)
+{
+    const auto &lines = input.getLines();
+
+    std::vector<Coordinate> cornerTiles;
+
+    // Get the red tiles (corners of polygon)
+    for (const auto &line : lines)
+    {
+        auto nums = common::str::to_vector_of_numbers(line, ',');
+        cornerTiles.emplace_back(nums[0], nums[1]);
+    }
+
+    // Index vertical and horizontal edges separately for fast crossing queries
+    const common::geometry::EdgeIndex edges(cornerTiles);
+
+    // Create a set of red tiles for fast lookup
+    std::unordered_set<Coordinate> redTileSet(cornerTiles.begin(), cornerTiles.end());
+
+    // Visit candidate rectangles largest-first so the first valid one is the answer and
+    // the polygon containment checks for every smaller rectangle are skipped.
+    auto isInsidePolygon = [&](const Coordinate &tile1, const Coordinate &tile2) {
+        // Skip if same row or column (degenerate rectangle)
+        if (tile1.x == tile2.x || tile1.y == tile2.y)
+            return false;
+
+        auto [minX, maxX] = std::minmax(tile1.x, tile2.x);
+        auto [minY, maxY] = std::minmax(tile1.y, tile2.y);
+
+        // Check no polygon edge crosses through the rectangle interior (cheap indexed query, so it goes first)
+        if (edges.crossesOpenRectangle(minX, maxX, minY, maxY))
+        {
+            return false;
+        }
+
+        // Check all 4 corners are inside or on the polygon
+        Coordinate corners[4] = {
+            {minX, minY}, {maxX, minY}, {minX, maxY}, {maxX, maxY}};
+
+        for (const auto &corner : corners)
+        {
+            // Corner is valid if it's ANY red tile or inside the polygon
+            bool isRedTile = redTileSet.contains(corner);
+            if (!isRedTile && !isPointInPolygon(cornerTiles, corner))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    };
+
+    common::geometry::RectangleSearchStats stats;
+    const auto maxArea = common::geometry::largestRectangleWhere(cornerTiles, isInsidePolygon, &stats);
+
+    context.log() << context.label() << ": pairs evaluated: " << stats.evaluated << ", pruned: " << stats.pruned
+                  << " (of " << stats.totalPairs << ")" << std::endl;
+
+    return static_cast<int64_t>(maxArea.value_or(0));
+}
+
+int64_t handlePart2Reference(const InputFile &input)
 {
     const auto &lines = input.getLines();
 
@@ -170,5 +233,7 @@ int64_t handlePart2(const InputFile &input)
         }
     }
 
-    return maxArea;
-}
\ No newline at end of file
+    return static_cast<int64_t>(maxArea);
+}
+
+} // namespace day09
\ No newline at end of file
@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <string_view>
+#include <vector>
+
+#include "BitsetUtils.hpp"
+#include "DynamicBitset.hpp"
+#include "TestHarness.hpp"
+#include "src/include.hpp"
+
+namespace {
+constexpr std::string_view kDayId = "10";
+constexpr std::string_view kSourcePath = __FILE__;
+}
+
+TEST(Day10Differential, Part1MatchesExhaustiveSearch)
+{
+    common::tests::expect_equivalent(day10::generateInput, day10::handlePart1Exhaustive, day10::handlePart1,
+                                     {.cases = 2000, .maxLines = 10});
+}
+
+TEST(Day10Differential, Part2MatchesPressEnumeration)
+{
+    common::tests::expect_equivalent(day10::generateInput, day10::handlePart2Reference, day10::handlePart2,
+                                     {.cases = 300, .maxLines = 1});
+}
+
+// Buttons narrower or wider than the lights count as zero-padded in both searches.
+TEST(Day10Differential, MixedWidthsMatchExhaustiveSearch)
+{
+    using common::DynamicBitset;
+    std::mt19937 rng(10);
+    for (int trial = 0; trial < 500; ++trial)
+    {
+        const auto randomBits = [&](std::size_t width) {
+            DynamicBitset bits(width);
+            for (std::size_t index = 0; index < width; ++index)
+            {
+                bits.set(index, rng() % 2 == 1);
+            }
+            return bits;
+        };
+        std::vector<DynamicBitset> buttons;
+        for (std::size_t i = rng() % 8; i > 0; --i)
+        {
+            buttons.push_back(randomBits(1 + rng() % 10));
+        }
+        const auto lights = randomBits(1 + rng() % 10);
+        const auto fast = common::bitset_utils::findMinimalXorSubset(buttons, lights);
+        const auto exhaustive = common::bitset_utils::findMinimalXorSubsetExhaustive(buttons, lights);
+        ASSERT_EQ(fast.has_value(), exhaustive.has_value()) << "trial " << trial;
+        if (fast)
+        {
+            EXPECT_EQ(fast->size(), exhaustive->size()) << "trial " << trial;
+        }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    return common::tests::runDifferentialTests(kDayId, kSourcePath, argc, argv);
+}
@@ -0,0 +1,63 @@
+/**
+ * Day-10 - Input generator
+ */
+#include "include.hpp"
+
+#include <vector>
+
+namespace day10
+{
+namespace
+{
+constexpr std::size_t kMachines = 170;
+constexpr int64_t kMinLights = 4;
+constexpr int64_t kMaxLights = 10;
+constexpr int64_t kMaxExtraButtons = 3;
+constexpr int64_t kMaxPresses = 20;
+} // namespace
+
+void generateInput(std::ostream &out, const common::gen::Params &params)
+{
+    common::gen::Random random(params.seed);
+    const auto count = common::gen::scaled(kMachines, params);
+    for (std::size_t m = 0; m < count; ++m)
+    {
+        const auto lightCount = static_cast<std::size_t>(random.between(kMinLights, kMaxLights));
+        const auto buttonCount = lightCount + static_cast<std::size_t>(random.between(-2, kMaxExtraButtons));
+
+        // Targets come from pressing the buttons, so both parts always have a solution: the
+        // lights are the parity of the presses and the joltages their totals.
+        std::vector<bool> lights(lightCount, false);
+        std::vector<int64_t> joltages(lightCount, 0);
+        std::string buttons;
+        for (std::size_t b = 0; b < buttonCount; ++b)
+        {
+            const auto wired = random.distinct(static_cast<std::size_t>(random.between(1, lightCount - 1)), 0,
+                                               static_cast<int64_t>(lightCount) - 1);
+            const auto presses = random.between(0, kMaxPresses);
+            buttons += " (";
+            for (std::size_t w = 0; w < wired.size(); ++w)
+            {
+                const auto light = static_cast<std::size_t>(wired[w]);
+                buttons += (w == 0 ? "" : ",") + std::to_string(light);
+                lights[light] = lights[light] != (presses % 2 == 1);
+                joltages[light] += presses;
+            }
+            buttons += ')';
+        }
+
+        out << '[';
+        for (const bool on : lights)
+        {
+            out << (on ? '#' : '.');
+        }
+        out << ']' << buttons << " {";
+        for (std::size_t j = 0; j < joltages.size(); ++j)
+        {
+            out << (j == 0 ? "" : ",") << joltages[j];
+        }
+        out << "}\n";
+    }
+}
+
+} // namespace day10
@@ -8,8 +8,22 @@
 #include <string_view>
 #include <vector>
 
+#include "Generator.hpp"
 #include "InputFile.hpp"
 #include "Utils.hpp"
 
+namespace day10
+{
 int64_t handlePart1(const InputFile &input);
-int64_t handlePart2(const InputFile &input);
\ No newline at end of file
+int64_t handlePart2(const InputFile &input);
+
+/// @brief Part 1 by trying every subset of buttons; the reference for differential tests.
+int64_t handlePart1Exhaustive(const InputFile &input);
+
+/// @brief Part 2 by enumerating press counts button by button; the reference for differential tests.
+int64_t handlePart2Reference(const InputFile &input);
+
+/// @brief Writes a synthetic input of machine descriptions with solvable targets; see generate.cpp for what the scale multiplies.
+void generateInput(std::ostream &out, const common::gen::Params &params);
+
+} // namespace day10
\ No newline at end of file
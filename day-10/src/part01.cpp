@@ -4,38 +4,36 @@
 #include "include.hpp"
 #include <ranges>
 #include <iostream>
-#include <bitset>
 
 using namespace std::ranges;
 
+namespace day10
+{
 struct Machine
 {
-    std::bitset<16> lights;
-    std::vector<std::bitset<16>> buttons;
+    common::DynamicBitset lights;
+    std::vector<common::DynamicBitset> buttons;
     std::vector<uint32_t> joltages;
 };
 
 static Machine parseMachineLine(const std::string &line)
 {
     Machine newMachine;
-    auto values = common::str::split(line, ' ');
-
-    for (const auto &val : values)
+    for (const auto val : common::str::tokens(line, ' '))
     {
 
         if (val.starts_with('['))
         {
+            // Width comes from the diagram, so any number of lights fits.
+            // The puzzle uses left-to-right as bit 0 to bit N, matching fromString.
             auto bitsStr = common::str::remove_chars(val, "[]");
-            // Reverse the string because bitset parses left-to-right as MSB-to-LSB,
-            // but the puzzle uses left-to-right as bit 0 to bit N
-            std::string reversed(bitsStr.rbegin(), bitsStr.rend());
-            newMachine.lights = std::bitset<16>(reversed, 0, reversed.size(), '.', '#');
+            newMachine.lights = common::DynamicBitset::fromString(bitsStr, '.', '#');
         }
         else if (val.starts_with('('))
         {
             const auto buttonsStr = common::str::remove_chars(val, "()");
             auto buttons = common::str::to_vector_of_numbers(buttonsStr, ',');
-            std::bitset<16> buttonBits;
+            common::DynamicBitset buttonBits(newMachine.lights.size());
             std::ranges::for_each(buttons, [&](auto button)
                                   { buttonBits.set(button); });
             newMachine.buttons.emplace_back(std::move(buttonBits));
@@ -48,32 +46,32 @@ static Machine parseMachineLine(const std::string &line)
     return newMachine;
 }
 
-int64_t handlePart1(const InputFile &input)
+static uint64_t solveMachine(const Machine &machine, common::parallel::TaskLog &log)
 {
-    const auto &lines = input.getLines();
-
-    std::vector<Machine> machines;
-
-    for (const auto &line : lines)
+    auto result = common::bitset_utils::findMinimalXorSubset(machine.buttons, machine.lights);
+    if (!result)
     {
-        auto newMachine = parseMachineLine(line);
-        machines.emplace_back(std::move(newMachine));
+        log << "Machine " << log.index() << ": failed to find answer" << std::endl;
+        return 0;
     }
+    return result->size();
+}
 
-    uint64_t total = 0;
+int64_t handlePart1(const InputFile &input)
+{
+    return common::parallel::mapReduce(input.getLines(), parseMachineLine, solveMachine, std::plus<>());
+}
 
-    for (const auto &machine : machines)
+int64_t handlePart1Exhaustive(const InputFile &input)
+{
+    int64_t total = 0;
+    for (const auto &line : input.getLines())
     {
-        auto result = common::bitset_utils::findMinimalXorSubset(machine.buttons, machine.lights);
-        if (result)
-        {
-            total += result->size();
-        }
-        else
-        {
-            std::cout << "Failed to find answer!!!!" << std::endl;
-        }
+        const auto machine = parseMachineLine(line);
+        const auto result = common::bitset_utils::findMinimalXorSubsetExhaustive(machine.buttons, machine.lights);
+        total += result ? static_cast<int64_t>(result->size()) : 0;
     }
-
     return total;
-}
\ No newline at end of file
+}
+
+} // namespace day10
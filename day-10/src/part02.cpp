@@ -5,29 +5,37 @@
  * Minimize sum(x) subject to Ax = b, x >= 0 (integers)
  *
  * Solution approach:
- * 1. Use Gaussian elimination to find RREF of [A|b]
+ * 1. Use fraction-free (Bareiss) Gauss-Jordan elimination to reduce [A|b] over the integers
  * 2. Identify pivot columns (basic variables) and free columns (free variables)
  * 3. Basic variables are uniquely determined by free variables via back-substitution
- * 4. Search over all valid assignments of free variables to find minimum sum
+ * 4. Branch and bound over the free variables to find the minimum sum
  *
  * The search is efficient because:
- * - AoC inputs have few free variables (typically 0-2)
- * - Pruning eliminates branches where current sum exceeds best known
- * - Feasibility constraints limit the search space
+ * - Each button is bounded by the smallest target among the counters it feeds
+ * - Every node tightens the next variable's range from the RREF rows
+ * - The total is linear in the free variables, so the LP relaxation of the rows over the
+ *   unassigned ones bounds a subtree, and any subtree whose bound reaches the best known
+ *   total is cut
+ * - Values are tried outward from the relaxation's optimum, so good totals are found early
  */
 #include "include.hpp"
+#include "LinearProgram.hpp"
 #include <ranges>
 #include <iostream>
 #include <cmath>
+#include <cstdlib>
 #include <limits>
 #include <algorithm>
+#include <array>
 #include <numeric>
-#include <queue>
+#include <optional>
 #include <set>
-#include <Eigen/Dense>
+#include <stdexcept>
 
 using namespace std::ranges;
 
+namespace day10
+{
 struct MachinePart2
 {
     std::vector<std::vector<uint32_t>> buttons;
@@ -37,9 +45,7 @@ struct MachinePart2
 static MachinePart2 parseMachineLine(const std::string &line)
 {
     MachinePart2 newMachine;
-    auto values = common::str::split(line, ' ');
-
-    for (const auto &val : values)
+    for (const auto val : common::str::tokens(line, ' '))
     {
 
         if (val.starts_with('['))
@@ -62,169 +68,397 @@ static MachinePart2 parseMachineLine(const std::string &line)
 }
 
 /**
- * Gaussian elimination with rational arithmetic to find exact solutions.
- * Uses fractions represented as pairs of integers to avoid floating point errors.
+ * Augmented integer matrix [A|b], filled straight from the button index lists.
+ * Each button is a sparse 0/1 column, so only its listed counters are written.
  */
-struct Rational
+static common::math::IntMatrix buildAugmentedMatrix(const MachinePart2 &machine)
 {
-    int64_t num;
-    int64_t den;
+    const std::size_t numCounters = machine.joltages.size();
+    const std::size_t numButtons = machine.buttons.size();
+    common::math::IntMatrix aug(numCounters, numButtons + 1);
+    for (std::size_t btnIdx = 0; btnIdx < numButtons; ++btnIdx)
+    {
+        for (uint32_t counterIdx : machine.buttons[btnIdx])
+        {
+            if (counterIdx < numCounters)
+            {
+                aug(counterIdx, btnIdx) = 1;
+            }
+        }
+    }
+    for (std::size_t i = 0; i < numCounters; ++i)
+    {
+        aug(i, numButtons) = machine.joltages[i];
+    }
+    return aug;
+}
 
-    Rational(int64_t n = 0, int64_t d = 1) : num(n), den(d) { normalize(); }
+/**
+ * Integer form of one RREF row: pivotCoeff * x[pivotCol] + sum(freeCoeffs[f] * x[freeCols[f]]) == rhs.
+ * Taken straight from the fraction-free elimination, divided once by the row's gcd.
+ */
+struct IntegerRow
+{
+    int pivotCol;
+    int64_t pivotCoeff;
+    std::vector<int64_t> freeCoeffs;
+    int64_t rhs;
+};
 
-    void normalize()
+/**
+ * Bounded branch-and-bound over the free variables.
+ *
+ * The total presses are linear in the free variables once the pivots are substituted:
+ *   scale * total = objectiveConst + sum(objectiveCoeffs[f] * x[f])
+ * Each node tightens the next variable's range from the rows, then bounds the subtree in two
+ * steps. The box bound (every unassigned variable at the cheaper end of its [0, upper] range)
+ * is a suffix sum precomputed per depth and cuts most nodes for free. Nodes that survive it
+ * solve the LP relaxation of the rows over the unassigned variables; its optimum is a lower
+ * bound on the subtree, and the next variable's values are tried outward from its value there.
+ * A subtree is cut once its bound reaches the best total found.
+ *
+ * The objective, the box bounds, the per-row ranges of the free variables and the pivot
+ * capacities are all built with checked arithmetic, so a machine whose coefficients do not
+ * fit in int64 throws std::overflow_error instead of pruning wrongly. Every partial objective,
+ * row sum and slack of the search lies between those precomputed extremes, so the search
+ * itself cannot overflow. The LP bound is only trusted while the objective is exact in a
+ * double, and is rounded with a tolerance for the simplex's own error.
+ */
+class FreeVariableSearch
+{
+public:
+    FreeVariableSearch(const std::vector<IntegerRow> &rows,
+                       const std::vector<int64_t> &freeUpper,
+                       const std::vector<int64_t> &pivotUpper)
+        : m_rows(rows), m_freeUpper(freeUpper), m_pivotUpper(pivotUpper),
+          m_partial(rows.size(), 0), m_values(freeUpper.size(), 0)
     {
-        if (den < 0)
+        using common::math::checkedAdd;
+        using common::math::checkedMul;
+        using common::math::checkedSub;
+
+        // scale = lcm of pivot coefficients, so every row's contribution is integral.
+        m_scale = 1;
+        for (const auto &row : m_rows)
         {
-            num = -num;
-            den = -den;
+            m_scale = checkedMul(m_scale / std::gcd(m_scale, row.pivotCoeff), std::abs(row.pivotCoeff));
         }
-        int64_t g = std::gcd(std::abs(num), std::abs(den));
-        if (g > 0)
+        m_objectiveConst = 0;
+        m_objectiveCoeffs.assign(m_freeUpper.size(), m_scale);
+        for (const auto &row : m_rows)
         {
-            num /= g;
-            den /= g;
+            const int64_t factor = m_scale / row.pivotCoeff;
+            m_objectiveConst = checkedAdd(m_objectiveConst, checkedMul(factor, row.rhs));
+            for (std::size_t f = 0; f < m_freeUpper.size(); ++f)
+            {
+                m_objectiveCoeffs[f] = checkedSub(m_objectiveCoeffs[f], checkedMul(factor, row.freeCoeffs[f]));
+            }
         }
-    }
 
-    Rational operator+(const Rational &other) const
-    {
-        return Rational(num * other.den + other.num * den, den * other.den);
+        // Branch on the tightest variables first.
+        m_order.resize(m_freeUpper.size());
+        std::iota(m_order.begin(), m_order.end(), 0);
+        std::sort(m_order.begin(), m_order.end(), [&](std::size_t lhs, std::size_t rhs) {
+            return m_freeUpper[lhs] < m_freeUpper[rhs];
+        });
+
+        // Box bound of the variables from each depth on; the dearer corners only check that
+        // the largest objective fits as well.
+        m_boxBound.assign(m_order.size() + 1, 0);
+        int64_t dearest = 0;
+        for (std::size_t d = m_order.size(); d-- > 0;)
+        {
+            const std::size_t f = m_order[d];
+            const int64_t corner = checkedMul(m_objectiveCoeffs[f], m_freeUpper[f]);
+            m_boxBound[d] = checkedAdd(m_boxBound[d + 1], std::min<int64_t>(0, corner));
+            dearest = checkedAdd(dearest, std::max<int64_t>(0, corner));
+        }
+        checkedAdd(m_objectiveConst, m_boxBound.front());
+        checkedAdd(m_objectiveConst, dearest);
+
+        // Range the free variables from each depth on can add to each row, and the most each
+        // pivot can take; every row slack of the search is a difference of these.
+        m_restLow.assign(m_rows.size(), std::vector<int64_t>(m_order.size() + 1, 0));
+        m_restHigh = m_restLow;
+        m_pivotCapacity.assign(m_rows.size(), 0);
+        for (std::size_t r = 0; r < m_rows.size(); ++r)
+        {
+            const auto &row = m_rows[r];
+            for (std::size_t d = m_order.size(); d-- > 0;)
+            {
+                const std::size_t f = m_order[d];
+                const int64_t extreme = checkedMul(row.freeCoeffs[f], m_freeUpper[f]);
+                m_restLow[r][d] = checkedAdd(m_restLow[r][d + 1], std::min<int64_t>(0, extreme));
+                m_restHigh[r][d] = checkedAdd(m_restHigh[r][d + 1], std::max<int64_t>(0, extreme));
+            }
+            m_pivotCapacity[r] = checkedMul(row.pivotCoeff, m_pivotUpper[row.pivotCol]);
+            checkedSub(row.rhs, m_restLow[r].front());
+            checkedSub(checkedSub(row.rhs, m_restHigh[r].front()), m_pivotCapacity[r]);
+        }
     }
 
-    Rational operator-(const Rational &other) const
+    std::optional<int64_t> run()
     {
-        return Rational(num * other.den - other.num * den, den * other.den);
+        search(0, 0);
+        return m_best;
     }
 
-    Rational operator*(const Rational &other) const
+    const std::vector<int64_t> &bestFreeValues() const { return m_bestValues; }
+    uint64_t nodesExplored() const { return m_nodes; }
+
+private:
+    /**
+     * LP relaxation of the subtree at depth: maximize -objective over the unassigned free
+     * variables, each in [0, upper], keeping every pivot within [0, pivotUpper]:
+     *   sum(coeff * x) <= remaining  and  -sum(coeff * x) <= pivotCoeff * pivotUpper - remaining
+     * Rows are scaled by their largest coefficient to keep the simplex well conditioned.
+     */
+    common::math::LinearProgramResult relax(std::size_t depth) const
     {
-        return Rational(num * other.num, den * other.den);
+        const std::size_t count = m_order.size() - depth;
+        std::vector<std::vector<double>> a;
+        std::vector<double> b;
+        a.reserve(2 * m_rows.size() + count);
+        b.reserve(2 * m_rows.size() + count);
+        for (std::size_t r = 0; r < m_rows.size(); ++r)
+        {
+            const auto &row = m_rows[r];
+            std::vector<double> coeffs(count);
+            double largest = 0.0;
+            for (std::size_t k = 0; k < count; ++k)
+            {
+                coeffs[k] = static_cast<double>(row.freeCoeffs[m_order[depth + k]]);
+                largest = std::max(largest, std::abs(coeffs[k]));
+            }
+            if (largest == 0.0)
+            {
+                continue;
+            }
+            const double remaining = static_cast<double>(row.rhs - m_partial[r]);
+            for (auto &coeff : coeffs)
+            {
+                coeff /= largest;
+            }
+            a.push_back(coeffs);
+            b.push_back(remaining / largest);
+            for (auto &coeff : coeffs)
+            {
+                coeff = -coeff;
+            }
+            a.push_back(std::move(coeffs));
+            b.push_back((static_cast<double>(m_pivotCapacity[r]) - remaining) / largest);
+        }
+        std::vector<double> c(count);
+        for (std::size_t k = 0; k < count; ++k)
+        {
+            const std::size_t f = m_order[depth + k];
+            std::vector<double> unit(count, 0.0);
+            unit[k] = 1.0;
+            a.push_back(std::move(unit));
+            b.push_back(static_cast<double>(m_freeUpper[f]));
+            c[k] = -static_cast<double>(m_objectiveCoeffs[f]);
+        }
+        return common::math::LinearProgram::maximize(a, b, c);
     }
 
-    Rational operator/(const Rational &other) const
+    static int64_t floorDiv(int64_t num, int64_t den)
     {
-        return Rational(num * other.den, den * other.num);
+        int64_t q = num / den;
+        if ((num % den != 0) && ((num < 0) != (den < 0)))
+        {
+            --q;
+        }
+        return q;
     }
 
-    bool isZero() const { return num == 0; }
-    bool isPositive() const { return num > 0; }
-    bool isNegative() const { return num < 0; }
-
-    double toDouble() const { return static_cast<double>(num) / static_cast<double>(den); }
-    int64_t toInt() const { return num / den; } // Only valid if den divides num
-    bool isInteger() const { return num % den == 0; }
-};
-
-struct RationalGaussResult
-{
-    std::vector<std::vector<Rational>> rref;
-    std::vector<int> pivotCols;
-    int rank;
-};
-
-static RationalGaussResult gaussianElimination(const Eigen::MatrixXd &A, const Eigen::VectorXd &b)
-{
-    int rows = A.rows();
-    int cols = A.cols();
-
-    // Create augmented matrix [A|b] with rationals
-    std::vector<std::vector<Rational>> aug(rows, std::vector<Rational>(cols + 1));
-    for (int i = 0; i < rows; ++i)
+    static int64_t ceilDiv(int64_t num, int64_t den)
     {
-        for (int j = 0; j < cols; ++j)
+        int64_t q = num / den;
+        if ((num % den != 0) && ((num < 0) == (den < 0)))
         {
-            aug[i][j] = Rational(static_cast<int64_t>(A(i, j)));
+            ++q;
         }
-        aug[i][cols] = Rational(static_cast<int64_t>(b(i)));
+        return q;
     }
 
-    std::vector<int> pivotCols;
-    int pivotRow = 0;
-
-    for (int col = 0; col < cols && pivotRow < rows; ++col)
+    void search(std::size_t depth, int64_t objectivePartial)
     {
-        // Find non-zero pivot
-        int foundRow = -1;
-        for (int row = pivotRow; row < rows; ++row)
+        ++m_nodes;
+
+        // Box bound: every unassigned variable at the cheaper end of its range.
+        const int64_t bound = m_objectiveConst + objectivePartial + m_boxBound[depth];
+        if (m_best && bound >= m_bestScaled)
         {
-            if (!aug[row][col].isZero())
+            return;
+        }
+
+        if (depth == m_order.size())
+        {
+            int64_t total = 0;
+            for (const auto value : m_values)
             {
-                foundRow = row;
-                break;
+                total += value;
             }
+            for (std::size_t r = 0; r < m_rows.size(); ++r)
+            {
+                const int64_t numerator = m_rows[r].rhs - m_partial[r];
+                if (numerator < 0 || numerator % m_rows[r].pivotCoeff != 0)
+                {
+                    return;
+                }
+                total += numerator / m_rows[r].pivotCoeff;
+            }
+            if (!m_best || total < *m_best)
+            {
+                m_best = total;
+                m_bestScaled = common::math::checkedMul(total, m_scale);
+                m_bestValues = m_values;
+            }
+            return;
         }
 
-        if (foundRow == -1)
+        // Tighten the range of the next variable from every row it appears in:
+        //   0 <= rhs - partial - coeff * x - rest <= pivotCoeff * pivotUpper
+        const std::size_t f = m_order[depth];
+        int64_t lo = 0;
+        int64_t hi = m_freeUpper[f];
+        for (std::size_t r = 0; r < m_rows.size() && lo <= hi; ++r)
+        {
+            const auto &row = m_rows[r];
+            const int64_t remaining = row.rhs - m_partial[r];
+            const int64_t coeff = row.freeCoeffs[f];
+            const int64_t upperSlack = remaining - m_restLow[r][depth + 1];
+            const int64_t lowerSlack = remaining - m_restHigh[r][depth + 1] - m_pivotCapacity[r];
+            if (coeff == 0)
+            {
+                if (upperSlack < 0 || lowerSlack > 0)
+                {
+                    return;
+                }
+                continue;
+            }
+            // lowerSlack <= coeff * x <= upperSlack
+            if (coeff > 0)
+            {
+                lo = std::max(lo, ceilDiv(lowerSlack, coeff));
+                hi = std::min(hi, floorDiv(upperSlack, coeff));
+            }
+            else
+            {
+                lo = std::max(lo, ceilDiv(upperSlack, coeff));
+                hi = std::min(hi, floorDiv(lowerSlack, coeff));
+            }
+        }
+        if (lo > hi)
         {
-            continue; // Skip this column
+            return;
         }
 
-        // Swap rows
-        std::swap(aug[pivotRow], aug[foundRow]);
-
-        // Scale pivot row to make pivot = 1
-        Rational pivot = aug[pivotRow][col];
-        for (int j = 0; j <= cols; ++j)
+        // The last variable's range is already exact, so the relaxation only pays off above it.
+        const bool cheaperLow = m_objectiveCoeffs[f] >= 0;
+        int64_t first = cheaperLow ? lo : hi;
+        if (depth + 1 < m_order.size())
         {
-            aug[pivotRow][j] = aug[pivotRow][j] / pivot;
+            const auto relaxation = relax(depth);
+            if (relaxation.status == common::math::LinearProgramResult::Status::Infeasible)
+            {
+                return;
+            }
+            if (relaxation.status == common::math::LinearProgramResult::Status::Optimal)
+            {
+                const double lpBound = static_cast<double>(m_objectiveConst + objectivePartial) - relaxation.value;
+                const double tolerance = 1e-6 + 1e-9 * std::abs(lpBound);
+                if (m_best && std::abs(lpBound) < kExactDouble &&
+                    std::ceil(lpBound - tolerance) >= static_cast<double>(m_bestScaled))
+                {
+                    return;
+                }
+                first = std::clamp<int64_t>(std::llround(relaxation.point.front()), lo, hi);
+            }
         }
 
-        // Eliminate other rows
-        for (int row = 0; row < rows; ++row)
+        // Outward from the first value, the cheaper neighbour first.
+        branch(depth, first, objectivePartial);
+        for (int64_t offset = 1; first - offset >= lo || first + offset <= hi; ++offset)
         {
-            if (row != pivotRow && !aug[row][col].isZero())
+            for (const int64_t value : cheaperLow ? std::array{first - offset, first + offset}
+                                                  : std::array{first + offset, first - offset})
             {
-                Rational factor = aug[row][col];
-                for (int j = 0; j <= cols; ++j)
+                if (value >= lo && value <= hi)
                 {
-                    aug[row][j] = aug[row][j] - factor * aug[pivotRow][j];
+                    branch(depth, value, objectivePartial);
                 }
             }
         }
+        m_values[m_order[depth]] = 0;
+    }
 
-        pivotCols.push_back(col);
-        pivotRow++;
+    void branch(std::size_t depth, int64_t value, int64_t objectivePartial)
+    {
+        const std::size_t f = m_order[depth];
+        m_values[f] = value;
+        for (std::size_t r = 0; r < m_rows.size(); ++r)
+        {
+            m_partial[r] += m_rows[r].freeCoeffs[f] * value;
+        }
+        search(depth + 1, objectivePartial + m_objectiveCoeffs[f] * value);
+        for (std::size_t r = 0; r < m_rows.size(); ++r)
+        {
+            m_partial[r] -= m_rows[r].freeCoeffs[f] * value;
+        }
     }
 
-    return {aug, pivotCols, static_cast<int>(pivotCols.size())};
-}
+    /// Magnitude below which every integer is exact in a double.
+    static constexpr double kExactDouble = 4503599627370496.0; // 2^52
+
+    const std::vector<IntegerRow> &m_rows;
+    const std::vector<int64_t> &m_freeUpper;
+    const std::vector<int64_t> &m_pivotUpper;
+    std::vector<int64_t> m_partial;
+    std::vector<int64_t> m_values;
+    std::vector<std::size_t> m_order;
+    int64_t m_scale = 1;
+    int64_t m_objectiveConst = 0;
+    std::vector<int64_t> m_objectiveCoeffs;
+    /// m_boxBound[d]: smallest objective the variables at depth d and beyond can add.
+    std::vector<int64_t> m_boxBound;
+    /// m_restLow[r][d] / m_restHigh[r][d]: range the variables at depth d and beyond can add to row r.
+    std::vector<std::vector<int64_t>> m_restLow;
+    std::vector<std::vector<int64_t>> m_restHigh;
+    /// pivotCoeff * pivotUpper per row: the most the row's pivot can take.
+    std::vector<int64_t> m_pivotCapacity;
+    std::optional<int64_t> m_best;
+    /// m_best * m_scale, the objective value the bound is compared with.
+    int64_t m_bestScaled = 0;
+    std::vector<int64_t> m_bestValues;
+    uint64_t m_nodes = 0;
+};
+
 /**
  * Solve using RREF and then optimize over free variables.
  */
-static int64_t solveMachine(const MachinePart2 &machine)
+static int64_t solveMachine(const MachinePart2 &machine, common::parallel::TaskLog &log)
 {
     const int numCounters = static_cast<int>(machine.joltages.size());
     const int numButtons = static_cast<int>(machine.buttons.size());
 
-    // Build the coefficient matrix A (counters x buttons)
-    Eigen::MatrixXd A(numCounters, numButtons);
-    A.setZero();
+    // Fraction-free Gauss-Jordan elimination on [A|b]
+    auto aug = buildAugmentedMatrix(machine);
+    const auto reduced = common::math::bareissReduce(aug, numButtons);
+    common::math::normalizeRows(aug, reduced);
+    const std::vector<int> pivotCols(reduced.pivotCols.begin(), reduced.pivotCols.end());
+    const int rank = static_cast<int>(reduced.rank);
 
-    for (int btnIdx = 0; btnIdx < numButtons; ++btnIdx)
+    // A zero row with a non-zero right-hand side means the targets are unreachable.
+    for (int i = rank; i < numCounters; ++i)
     {
-        for (uint32_t counterIdx : machine.buttons[btnIdx])
+        if (aug(i, numButtons) != 0)
         {
-            if (static_cast<int>(counterIdx) < numCounters)
-            {
-                A(counterIdx, btnIdx) = 1.0;
-            }
+            log << "Warning: No feasible solution found!" << std::endl;
+            return 0;
         }
     }
 
-    // Build the target vector b
-    Eigen::VectorXd b(numCounters);
-    for (int i = 0; i < numCounters; ++i)
-    {
-        b(i) = static_cast<double>(machine.joltages[i]);
-    }
-
-    // Gaussian elimination
-    auto result = gaussianElimination(A, b);
-    const auto &rref = result.rref;
-    const auto &pivotCols = result.pivotCols;
-    int rank = result.rank;
-
     // Identify free variables (non-pivot columns)
     std::vector<int> freeCols;
     std::set<int> pivotSet(pivotCols.begin(), pivotCols.end());
@@ -236,202 +470,239 @@ static int64_t solveMachine(const MachinePart2 &machine)
         }
     }
 
-    // Debug: print dimensions (comment out for production)
-    std::cerr << "Counters: " << numCounters << ", Buttons: " << numButtons
-              << ", Rank: " << rank << ", Free vars: " << freeCols.size() << std::endl;
-
-    // For each assignment of free variables, compute basic variables
-    // and check feasibility (all >= 0)
-    // Then find minimum sum
-
-    // If no free variables, we have a unique solution
-    if (freeCols.empty())
+    // Every coefficient is non-negative, so a button can never be pressed more often than
+    // the smallest target among the counters it feeds. Buttons that feed nothing stay at 0.
+    std::vector<int64_t> buttonUpper(numButtons, 0);
+    for (int btnIdx = 0; btnIdx < numButtons; ++btnIdx)
     {
-        // The solution is: x[pivotCols[i]] = rref[i][numButtons] for i in 0..rank-1
-        // Other variables (if numButtons > rank) are 0
-        std::vector<int64_t> solution(numButtons, 0);
-        int64_t totalPresses = 0;
-        bool valid = true;
-
-        for (int i = 0; i < rank; ++i)
+        int64_t upper = -1;
+        for (uint32_t counterIdx : machine.buttons[btnIdx])
         {
-            Rational val = rref[i][numButtons];
-            if (!val.isInteger())
-            {
-                std::cerr << "Warning: Non-integer solution for button " << pivotCols[i] << std::endl;
-                valid = false;
-            }
-            int64_t presses = val.toInt();
-            if (presses < 0)
+            if (static_cast<int>(counterIdx) < numCounters)
             {
-                std::cerr << "Warning: Negative presses in unique solution for button " << pivotCols[i] << std::endl;
-                valid = false;
+                const int64_t target = machine.joltages[counterIdx];
+                upper = upper < 0 ? target : std::min(upper, target);
             }
-            solution[pivotCols[i]] = presses;
-            totalPresses += presses;
         }
+        buttonUpper[btnIdx] = std::max<int64_t>(upper, 0);
+    }
+    std::vector<int64_t> freeUpper;
+    for (int col : freeCols)
+    {
+        freeUpper.push_back(buttonUpper[col]);
+    }
 
-        // Verify the solution
-        std::vector<int64_t> counters(numCounters, 0);
-        for (int btnIdx = 0; btnIdx < numButtons; ++btnIdx)
+    std::vector<IntegerRow> rows;
+    for (int i = 0; i < rank; ++i)
+    {
+        IntegerRow row{pivotCols[i], aug(i, pivotCols[i]), {}, aug(i, numButtons)};
+        for (int col : freeCols)
         {
-            for (uint32_t counterIdx : machine.buttons[btnIdx])
-            {
-                if (static_cast<int>(counterIdx) < numCounters)
-                {
-                    counters[counterIdx] += solution[btnIdx];
-                }
-            }
+            row.freeCoeffs.push_back(aug(i, col));
+        }
+        rows.push_back(std::move(row));
+    }
+
+    FreeVariableSearch search(rows, freeUpper, buttonUpper);
+    const auto best = search.run();
+
+    // What the previous unpruned grid search over [0, maxJoltage]^k would have visited.
+    const int64_t maxJoltage = *std::max_element(machine.joltages.begin(), machine.joltages.end());
+    const double gridNodes = std::pow(static_cast<double>(maxJoltage + 1), static_cast<double>(freeCols.size()));
+    log << "Counters: " << numCounters << ", Buttons: " << numButtons << ", Rank: " << rank
+        << ", Free vars: " << freeCols.size() << ", Nodes explored: " << search.nodesExplored()
+        << " (grid search: " << gridNodes << ")" << std::endl;
+
+    if (!best)
+    {
+        log << "Warning: No feasible solution found!" << std::endl;
+        return 0;
+    }
+
+    // Rebuild the full press vector and verify it against the original constraints
+    std::vector<int64_t> bestSolution(numButtons, 0);
+    const auto &freeValues = search.bestFreeValues();
+    for (std::size_t f = 0; f < freeCols.size(); ++f)
+    {
+        bestSolution[freeCols[f]] = freeValues[f];
+    }
+    for (const auto &row : rows)
+    {
+        int64_t numerator = row.rhs;
+        for (std::size_t f = 0; f < freeCols.size(); ++f)
+        {
+            numerator -= row.freeCoeffs[f] * freeValues[f];
         }
+        bestSolution[row.pivotCol] = numerator / row.pivotCoeff;
+    }
 
-        for (int i = 0; i < numCounters; ++i)
+    std::vector<int64_t> counters(numCounters, 0);
+    for (int btnIdx = 0; btnIdx < numButtons; ++btnIdx)
+    {
+        for (uint32_t counterIdx : machine.buttons[btnIdx])
         {
-            if (counters[i] != static_cast<int64_t>(machine.joltages[i]))
+            if (static_cast<int>(counterIdx) < numCounters)
             {
-                std::cerr << "ERROR (unique): Counter " << i << " is " << counters[i]
-                          << " but should be " << machine.joltages[i] << std::endl;
-                valid = false;
+                counters[counterIdx] += bestSolution[btnIdx];
             }
         }
+    }
 
-        if (!valid)
+    bool valid = true;
+    for (int i = 0; i < numCounters; ++i)
+    {
+        if (counters[i] != static_cast<int64_t>(machine.joltages[i]))
         {
-            std::cerr << "Unique solution verification failed!" << std::endl;
+            log << "ERROR: Counter " << i << " is " << counters[i]
+                << " but should be " << machine.joltages[i] << std::endl;
+            valid = false;
         }
-
-        return totalPresses;
+    }
+    if (!valid)
+    {
+        log << "Solution verification failed!" << std::endl;
     }
 
-    // We have free variables - need to search over them
-    // For each free variable, determine its valid range
+    log << "Machine " << log.index() << ": " << *best << " presses" << std::endl;
+    return *best;
+}
+
+int64_t handlePart2(const InputFile &input)
+{
+    return common::parallel::mapReduce(input.getLines(), parseMachineLine, solveMachine, std::plus<>());
+}
 
-    // Use BFS/DFS to search over free variable assignments
-    // This is exponential in the number of free variables, but AoC
-    // problems are designed to be tractable
-    // Compute upper bounds for free variables
-    // A simple bound: the free variable can't exceed the maximum RHS value
-    // since pressing a button more times than needed is wasteful
-    int maxJoltage = *std::max_element(machine.joltages.begin(), machine.joltages.end());
-    std::vector<int> freeUpperBounds(freeCols.size(), maxJoltage);
+/**
+ * Reference search: plain bounded enumeration of press counts. Each step picks the unfinished
+ * counter fed by the fewest unassigned buttons; a lone button is forced to cover it, otherwise
+ * one of them tries every count up to the smallest remaining target it feeds. A branch stops
+ * once its presses plus the largest remaining target cannot beat the best total. Machines
+ * that need more than kNodeBudget steps are rejected, so a differential test skips them.
+ */
+class PressEnumeration
+{
+public:
+    static constexpr uint64_t kNodeBudget = 20'000;
 
-    // BFS over free variable space
-    int64_t bestSum = std::numeric_limits<int64_t>::max();
+    explicit PressEnumeration(const MachinePart2 &machine)
+        : m_remaining(machine.joltages.begin(), machine.joltages.end()), m_assigned(machine.buttons.size(), false)
+    {
+        for (const auto &button : machine.buttons)
+        {
+            auto &counters = m_buttons.emplace_back();
+            for (uint32_t counterIdx : button)
+            {
+                if (counterIdx < m_remaining.size())
+                {
+                    counters.push_back(counterIdx);
+                }
+            }
+        }
+    }
 
-    // Helper to compute solution and check feasibility
-    auto computeSolution = [&](const std::vector<int64_t> &freeVals) -> std::tuple<bool, int64_t, std::vector<int64_t>>
+    std::optional<int64_t> run()
     {
-        std::vector<int64_t> solution(numButtons, 0);
+        search(0);
+        return m_best;
+    }
 
-        // Set free variables
-        for (size_t i = 0; i < freeCols.size(); ++i)
+private:
+    void search(int64_t presses)
+    {
+        if (++m_nodes > kNodeBudget)
         {
-            solution[freeCols[i]] = freeVals[i];
+            throw std::runtime_error("Press enumeration exceeded its node budget");
+        }
+        int64_t maxRemaining = 0;
+        for (const auto need : m_remaining)
+        {
+            maxRemaining = std::max(maxRemaining, need);
+        }
+        if (m_best && presses + maxRemaining >= *m_best)
+        {
+            return;
+        }
+        if (maxRemaining == 0)
+        {
+            m_best = presses;
+            return;
         }
 
-        // Compute basic variables from RREF (back-substitution)
-        for (int i = rank - 1; i >= 0; --i)
+        // The unfinished counter with the fewest buttons left to feed it.
+        std::size_t fewest = m_buttons.size() + 1;
+        std::size_t branchCounter = 0;
+        for (std::size_t counterIdx = 0; counterIdx < m_remaining.size(); ++counterIdx)
         {
-            Rational val = rref[i][numButtons];
-            for (int j = pivotCols[i] + 1; j < numButtons; ++j)
+            if (m_remaining[counterIdx] == 0)
             {
-                val = val - rref[i][j] * Rational(solution[j]);
+                continue;
             }
-            if (!val.isInteger())
+            std::size_t feeding = 0;
+            for (std::size_t btnIdx = 0; btnIdx < m_buttons.size(); ++btnIdx)
             {
-                return {false, 0, {}};
+                feeding += !m_assigned[btnIdx] && feeds(btnIdx, counterIdx) ? 1 : 0;
             }
-            int64_t intVal = val.toInt();
-            if (intVal < 0)
+            if (feeding == 0)
             {
-                return {false, 0, {}};
+                return;
             }
-            solution[pivotCols[i]] = intVal;
-        }
-
-        int64_t totalSum = std::accumulate(solution.begin(), solution.end(), 0LL);
-        return {true, totalSum, solution};
-    };
-
-    std::vector<int64_t> bestSolution;
-
-    // Use DFS to search over free variable assignments (no early pruning on currentFreeSum)
-    std::function<void(int, std::vector<int64_t> &)> search;
-    search = [&](int freeIdx, std::vector<int64_t> &freeVals)
-    {
-        if (freeIdx == static_cast<int>(freeCols.size()))
-        {
-            auto [feasible, totalSum, solution] = computeSolution(freeVals);
-            if (feasible && totalSum < bestSum)
+            if (feeding < fewest)
             {
-                bestSum = totalSum;
-                bestSolution = solution;
+                fewest = feeding;
+                branchCounter = counterIdx;
             }
-            return;
+        }
+        std::size_t branchButton = 0;
+        while (m_assigned[branchButton] || !feeds(branchButton, branchCounter))
+        {
+            ++branchButton;
         }
 
-        // Try values for this free variable from 0 to upper bound
-        for (int64_t val = 0; val <= freeUpperBounds[freeIdx]; ++val)
+        int64_t upper = std::numeric_limits<int64_t>::max();
+        for (std::size_t counterIdx : m_buttons[branchButton])
         {
-            freeVals[freeIdx] = val;
-            search(freeIdx + 1, freeVals);
+            upper = std::min(upper, m_remaining[counterIdx]);
         }
-    };
+        const int64_t lower = fewest == 1 ? m_remaining[branchCounter] : 0;
 
-    std::vector<int64_t> freeVals(freeCols.size(), 0);
-    search(0, freeVals);
+        m_assigned[branchButton] = true;
+        for (int64_t value = upper; value >= lower; --value)
+        {
+            press(branchButton, value);
+            search(presses + value);
+            press(branchButton, -value);
+        }
+        m_assigned[branchButton] = false;
+    }
 
-    if (bestSum == std::numeric_limits<int64_t>::max())
+    bool feeds(std::size_t btnIdx, std::size_t counterIdx) const
     {
-        std::cerr << "Warning: No feasible solution found!" << std::endl;
-        return 0;
+        return std::find(m_buttons[btnIdx].begin(), m_buttons[btnIdx].end(), counterIdx) != m_buttons[btnIdx].end();
     }
 
-    // Verify the solution is correct
-    if (!bestSolution.empty())
+    void press(std::size_t btnIdx, int64_t times)
     {
-        std::vector<int64_t> counters(numCounters, 0);
-        for (int btnIdx = 0; btnIdx < numButtons; ++btnIdx)
+        for (std::size_t counterIdx : m_buttons[btnIdx])
         {
-            for (uint32_t counterIdx : machine.buttons[btnIdx])
-            {
-                if (static_cast<int>(counterIdx) < numCounters)
-                {
-                    counters[counterIdx] += bestSolution[btnIdx];
-                }
-            }
-        }
-
-        bool valid = true;
-        for (int i = 0; i < numCounters; ++i)
-        {
-            if (counters[i] != static_cast<int64_t>(machine.joltages[i]))
-            {
-                std::cerr << "ERROR: Counter " << i << " is " << counters[i]
-                          << " but should be " << machine.joltages[i] << std::endl;
-                valid = false;
-            }
-        }
-        if (!valid)
-        {
-            std::cerr << "Solution verification failed!" << std::endl;
+            m_remaining[counterIdx] -= times;
         }
     }
 
-    return bestSum;
-}
+    std::vector<int64_t> m_remaining;
+    std::vector<std::vector<std::size_t>> m_buttons;
+    std::vector<bool> m_assigned;
+    std::optional<int64_t> m_best;
+    uint64_t m_nodes = 0;
+};
 
-int64_t handlePart2(const InputFile &input)
+int64_t handlePart2Reference(const InputFile &input)
 {
-    const auto &lines = input.getLines();
     int64_t total = 0;
-
-    int machineNum = 0;
-    for (const auto &line : lines)
+    for (const auto &line : input.getLines())
     {
-        auto machine = parseMachineLine(line);
-        int64_t machinePresses = solveMachine(machine);
-        std::cerr << "Machine " << machineNum++ << ": " << machinePresses << " presses" << std::endl;
-        total += machinePresses;
+        total += PressEnumeration(parseMachineLine(line)).run().value_or(0);
     }
     return total;
-}
\ No newline at end of file
+}
+
+} // namespace day10
@@ -1,8 +1,14 @@
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <sstream>
 #include <string_view>
+#include <thread>
+#include <vector>
 
+#include "DayRegistry.hpp"
 #include "Runner.hpp"
+#include "Server.hpp"
 #include "TestHarness.hpp"
 #include "src/include.hpp"
 
@@ -30,21 +36,19 @@ void runSampleSuite(common::tests::Part part)
         {
             if (testCase.expected.empty())
             {
-                auto inputFile = common::tests::makeInput(testCase);
-                handlePart1(inputFile);
+                common::tests::run_part(testCase, day11::handlePart1);
                 continue;
             }
-            common::tests::expect_part(testCase, handlePart1);
+            common::tests::expect_part(testCase, day11::handlePart1);
         }
         else
         {
             if (testCase.expected.empty())
             {
-                auto inputFile = common::tests::makeInput(testCase);
-                handlePart2(inputFile);
+                common::tests::run_part(testCase, day11::handlePart2);
                 continue;
             }
-            common::tests::expect_part(testCase, handlePart2);
+            common::tests::expect_part(testCase, day11::handlePart2);
         }
     }
 }
@@ -60,7 +64,60 @@ TEST(Day11Part2Samples, ValidateExamples)
     runSampleSuite(common::tests::Part::Two);
 }
 
+// Solvers keep all state in their SolverContext, so concurrent invocations must not interfere.
+TEST(Day11Concurrency, SixtyFourConcurrentRuns)
+{
+    constexpr int kCopies = 64;
+    const auto &part1Cases = common::tests::cases(common::tests::Part::One);
+    const auto &part2Cases = common::tests::cases(common::tests::Part::Two);
+    if (part1Cases.empty() && part2Cases.empty())
+    {
+        GTEST_SKIP() << "No sample cases provided yet.";
+    }
+
+    std::atomic<int> mismatches{0};
+    std::vector<std::thread> threads;
+    threads.reserve(kCopies);
+    for (int copy = 0; copy < kCopies; ++copy)
+    {
+        threads.emplace_back([&, copy] {
+            const bool partTwo = copy % 2 == 1;
+            const auto &cases = partTwo ? part2Cases : part1Cases;
+            const auto solver = partTwo ? day11::handlePart2 : day11::handlePart1;
+            for (const auto &testCase : cases)
+            {
+                const auto result = common::tests::run_part(testCase, solver);
+                if (!testCase.expected.empty() && result != testCase.expected)
+                {
+                    ++mismatches;
+                }
+            }
+        });
+    }
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+    EXPECT_EQ(mismatches.load(), 0);
+}
+
+// An oversized inline count must get an error reply, not take the server down, and the
+// unread payload must not be parsed as requests.
+TEST(Day11Serve, OversizedInlineCountIsRejected)
+{
+    common::DayRegistry registry;
+    registry.add(std::string(kDayId), {}, day11::handlePart1, day11::handlePart2);
+    for (const char *count : {"99999999999999", "999999999999999999999999"})
+    {
+        std::istringstream in("11 1 inline " + std::string(count) + "\nping\n");
+        std::ostringstream out;
+        EXPECT_EQ(common::server::serveStream(registry.days(), in, out), 0);
+        EXPECT_EQ(out.str(), "error inline input too large\n") << count;
+    }
+}
+
 int main(int argc, char **argv)
 {
-    return common::runDay(argc, argv, kDayId, kSourcePath, handlePart1, handlePart2);
+    return common::runDay(argc, argv, kDayId, kSourcePath, day11::handlePart1, day11::handlePart2,
+                           day11::generateInput);
 }
\ No newline at end of file
@@ -0,0 +1,130 @@
+/**
+ * Day-11 - Input generator
+ */
+#include "include.hpp"
+
+#include <algorithm>
+#include <array>
+#include <ranges>
+#include <string_view>
+#include <vector>
+
+namespace day11
+{
+namespace
+{
+constexpr std::size_t kDevices = 600;
+/// Successors are drawn from the next kWindow * scale devices in topological order. Growing
+/// the window with the scale keeps paths as long as in the real input, so the path counts
+/// still fit in 64 bits.
+constexpr std::size_t kWindow = 60;
+/// The last devices feed "out" directly.
+constexpr std::size_t kSinks = 8;
+constexpr std::array<std::string_view, 5> kReserved{"you", "svr", "fft", "dac", "out"};
+
+/// Random distinct lowercase names, three letters long until the device count needs more.
+std::vector<std::string> deviceNames(common::gen::Random &random, std::size_t count)
+{
+    std::size_t width = 3;
+    int64_t space = 26 * 26 * 26;
+    while (space < 4 * static_cast<int64_t>(count + kReserved.size()))
+    {
+        ++width;
+        space *= 26;
+    }
+
+    std::vector<std::string> names;
+    names.reserve(count);
+    for (auto code : random.distinct(count + kReserved.size(), 0, space - 1))
+    {
+        std::string name(width, 'a');
+        for (auto &letter : name | std::views::reverse)
+        {
+            letter = static_cast<char>('a' + code % 26);
+            code /= 26;
+        }
+        if (std::ranges::find(kReserved, name) == kReserved.end() && names.size() < count)
+        {
+            names.push_back(std::move(name));
+        }
+    }
+    random.shuffle(names);
+    return names;
+}
+} // namespace
+
+void generateInput(std::ostream &out, const common::gen::Params &params)
+{
+    common::gen::Random random(params.seed);
+    const auto count = std::max(common::gen::scaled(kDevices, params), 4 * kSinks);
+    const auto lastInner = static_cast<int64_t>(count - kSinks) - 1;
+    const auto window = static_cast<int64_t>(common::gen::scaled(kWindow, params));
+
+    // Devices are numbered in topological order and only link forwards, so the graph is a
+    // DAG. The named devices sit at fixed fractions of that order.
+    auto names = deviceNames(random, count);
+    const std::size_t svr = 0;
+    const std::size_t fft = count / 4;
+    const std::size_t you = count / 3;
+    const std::size_t dac = count / 2;
+    names[svr] = "svr";
+    names[fft] = "fft";
+    names[you] = "you";
+    names[dac] = "dac";
+
+    std::vector<std::vector<std::size_t>> successors(count);
+    const auto link = [&](int64_t from, int64_t to) {
+        successors[static_cast<std::size_t>(from)].push_back(static_cast<std::size_t>(to));
+    };
+    for (int64_t i = 0; i <= lastInner; ++i)
+    {
+        static constexpr std::array<int64_t, 6> kFanOut{1, 1, 1, 2, 2, 3};
+        const auto fanOut = kFanOut[static_cast<std::size_t>(random.between(0, kFanOut.size() - 1))];
+        for (int64_t n = 0; n < fanOut; ++n)
+        {
+            link(i, random.between(i + 1, std::min<int64_t>(static_cast<int64_t>(count) - 1, i + window)));
+        }
+    }
+    // Every device hangs off an earlier one, so all are reachable from svr, and a planted
+    // chain leads from fft to dac. Together with every device reaching out, both parts
+    // have paths to count.
+    for (int64_t j = 1; j < static_cast<int64_t>(count); ++j)
+    {
+        link(random.between(std::max<int64_t>(0, j - window), std::min(j - 1, lastInner)), j);
+    }
+    for (auto from = static_cast<int64_t>(fft); from < static_cast<int64_t>(dac);)
+    {
+        const auto to = std::min(static_cast<int64_t>(dac), from + random.between(1, window));
+        link(from, to);
+        from = to;
+    }
+
+    std::vector<std::string> lines;
+    lines.reserve(count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        auto &outputs = successors[i];
+        std::ranges::sort(outputs);
+        outputs.erase(std::unique(outputs.begin(), outputs.end()), outputs.end());
+        std::string line = names[i] + ":";
+        for (const auto output : outputs)
+        {
+            line += ' ';
+            line += names[output];
+        }
+        if (outputs.empty())
+        {
+            line += " out";
+        }
+        lines.push_back(std::move(line));
+    }
+
+    // List devices in random order, as the puzzle does.
+    random.shuffle(lines);
+    for (const auto &line : lines)
+    {
+        out << line << '\n';
+    }
+}
+
+} // namespace day11
@@ -8,8 +8,17 @@
 #include <string_view>
 #include <vector>
 
+#include "Generator.hpp"
 #include "InputFile.hpp"
+#include "SolverContext.hpp"
 #include "Utils.hpp"
 
-int64_t handlePart1(const InputFile &input);
-int64_t handlePart2(const InputFile &input);
\ No newline at end of file
+namespace day11
+{
+int64_t handlePart1(const InputFile &input, common::SolverContext &context);
+int64_t handlePart2(const InputFile &input, common::SolverContext &context);
+
+/// @brief Writes a synthetic input of a device DAG; see generate.cpp for what the scale multiplies.
+void generateInput(std::ostream &out, const common::gen::Params &params);
+
+} // namespace day11
\ No newline at end of file
@@ -2,60 +2,22 @@
  * Day-11 - Part 01
  */
 #include "include.hpp"
-#include <ranges>
-#include <iostream>
-#include <unordered_map>
 
-using namespace std::ranges;
-
-using DevMap = std::unordered_map<std::string, std::vector<std::string>>;
-static DevMap devices;
-static uint64_t total = 0;
-static const std::string YOU = "you";
-static const std::string OUT = "out";
-
-static void findExit(const std::string &currDevice)
+namespace day11
 {
-
-    auto &next = devices[currDevice];
-
-    if (next[0] != OUT)
-    {
-        for (const auto &link : next)
-        {
-            if (link == YOU)
-            {
-                continue;
-            }
-
-            findExit(link);
-        }
-    }
-    else
-    {
-        // Found OUT, so add to count and return.
-        total++;
-    }
-}
-
-int64_t handlePart1(const InputFile &input)
+int64_t handlePart1(const InputFile &input, common::SolverContext &context)
 {
-    // Reset globals in case samples and real input run in the same process
-    devices.clear();
-    total = 0;
-
-    const auto &lines = input.getLines();
-
-    // Parse out the lines into a map.
-    for (const auto &line : lines)
+    const auto devices = common::graph::parseAdjacencyLines(input.getLines());
+    const auto you = devices.names.find("you");
+    const auto out = devices.names.find("out");
+    context.log() << context.label() << ": " << devices.graph.nodeCount() << " devices, "
+                  << devices.graph.edgeCount() << " links" << std::endl;
+    if (!you || !out)
     {
-        const auto parts = common::str::split(line, ':');
-        const auto &key = parts[0];
-        const auto outputs = common::str::split(parts[1], ' ');
-        devices[key] = std::move(outputs);
+        return 0;
     }
 
-    findExit(YOU);
+    return static_cast<int64_t>(common::graph::countPaths(devices.graph, *you, *out));
+}
 
-    return total;
-}
\ No newline at end of file
+} // namespace day11
\ No newline at end of file
@@ -0,0 +1,69 @@
+/**
+ * Day-12 - Input generator
+ */
+#include "include.hpp"
+
+#include <array>
+#include <vector>
+
+namespace day12
+{
+namespace
+{
+constexpr std::size_t kShapes = 6;
+constexpr std::size_t kShapeSide = 3;
+constexpr std::size_t kRegions = 1000;
+constexpr int64_t kMinSide = 35;
+constexpr int64_t kMaxSide = 50;
+} // namespace
+
+void generateInput(std::ostream &out, const common::gen::Params &params)
+{
+    common::gen::Random random(params.seed);
+
+    // Six 3x3 presents of five to seven cells each. The scale only adds regions.
+    std::array<int64_t, kShapes> shapeCells{};
+    for (std::size_t s = 0; s < kShapes; ++s)
+    {
+        constexpr auto kCells = static_cast<int64_t>(kShapeSide * kShapeSide);
+        const auto filled = random.distinct(static_cast<std::size_t>(random.between(5, 7)), 0, kCells - 1);
+        shapeCells[s] = static_cast<int64_t>(filled.size());
+        std::string cells(kShapeSide * kShapeSide, '.');
+        for (const auto cell : filled)
+        {
+            cells[static_cast<std::size_t>(cell)] = '#';
+        }
+        out << s << ":\n";
+        for (std::size_t row = 0; row < kShapeSide; ++row)
+        {
+            out << cells.substr(row * kShapeSide, kShapeSide) << '\n';
+        }
+        out << '\n';
+    }
+
+    const auto count = common::gen::scaled(kRegions, params);
+    for (std::size_t r = 0; r < count; ++r)
+    {
+        const auto width = random.between(kMinSide, kMaxSide);
+        const auto height = random.between(kMinSide, kMaxSide);
+        // Like the puzzle, regions are either comfortably loose or hopelessly overfull.
+        const double fill = random.chance(0.5) ? 0.55 + 0.2 * random.real() : 1.0 + 0.1 * random.real();
+        const auto target = static_cast<int64_t>(fill * static_cast<double>(width * height));
+
+        std::array<int64_t, kShapes> presents{};
+        for (int64_t cells = 0; cells < target;)
+        {
+            const auto shape = static_cast<std::size_t>(random.between(0, kShapes - 1));
+            ++presents[shape];
+            cells += shapeCells[shape];
+        }
+        out << width << 'x' << height << ':';
+        for (const auto present : presents)
+        {
+            out << ' ' << present;
+        }
+        out << '\n';
+    }
+}
+
+} // namespace day12
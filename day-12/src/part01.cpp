@@ -12,6 +12,8 @@
 
 using namespace std::ranges;
 
+namespace day12
+{
 // Parse a shape definition and return the number of '#' cells
 int parseShapeSize(const std::vector<std::string> &lines, size_t &lineIdx)
 {
@@ -113,4 +115,6 @@ int64_t handlePart1(const InputFile &input)
     }
 
     return count;
-}
\ No newline at end of file
+}
+
+} // namespace day12
\ No newline at end of file
@@ -7,8 +7,12 @@
 
 using namespace std::ranges;
 
+namespace day12
+{
 int64_t handlePart2(const InputFile &input) {
     const auto &lines = input.getLines();
     (void)lines;
     return 0;
-}
\ No newline at end of file
+}
+
+} // namespace day12
\ No newline at end of file
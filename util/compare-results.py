@@ -0,0 +1,98 @@
+# /// script
+# requires-python = ">=3.12"
+# dependencies = []
+# ///
+"""Compare two runner result files (--format=json|csv, --bench-json or aoc-all) and flag
+phases whose metric got worse by more than a threshold.
+
+Usage: uv run util/compare-results.py baseline.json candidate.json [--threshold 0.1]
+       [--metric median] [--min-value 0.0001]
+
+Records are matched by (day, phase). A changed answer is always reported. The exit status
+is 1 if there are regressions or changed answers, 0 otherwise.
+"""
+import argparse
+import csv
+import json
+import sys
+
+# Lower is better for every metric the runner writes.
+METRICS = (
+    "min", "median", "mean", "p99", "max",
+    "allocations", "bytes", "peak_live_bytes", "peak_rss_bytes",
+    "cycles", "instructions", "cache_misses", "branch_misses", "page_faults",
+)
+
+
+def load(path):
+    with open(path, newline="") as f:
+        if path.endswith(".csv"):
+            rows = list(csv.DictReader(f))
+        else:
+            rows = json.load(f)["results"]
+    records = {}
+    for row in rows:
+        records[(row["day"], row["phase"])] = row
+    return records
+
+
+def number(row, metric):
+    value = row.get(metric)
+    if value is None or value == "":
+        return None
+    return float(value)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("baseline")
+    parser.add_argument("candidate")
+    parser.add_argument("--threshold", type=float, default=0.10,
+                        help="relative increase that counts as a regression (default 0.10)")
+    parser.add_argument("--metric", choices=METRICS, default="median",
+                        help="field to compare (default median)")
+    parser.add_argument("--min-value", type=float, default=1e-4,
+                        help="ignore phases where both values are below this, e.g. timer noise "
+                             "(default 1e-4, i.e. 0.1 ms for times)")
+    args = parser.parse_args()
+
+    baseline = load(args.baseline)
+    candidate = load(args.candidate)
+
+    problems = 0
+    print(f"{'day':<5} {'phase':<7} {'baseline':>14} {'candidate':>14} {'change':>9}  status")
+    for key in sorted(baseline.keys() | candidate.keys()):
+        day, phase = key
+        old_row, new_row = baseline.get(key), candidate.get(key)
+        if old_row is None or new_row is None:
+            print(f"{day:<5} {phase:<7} {'':>14} {'':>14} {'':>9}  only in {'candidate' if old_row is None else 'baseline'}")
+            continue
+
+        status = []
+        if (old_row.get("answer") or "") != (new_row.get("answer") or ""):
+            status.append(f"ANSWER CHANGED ({old_row.get('answer')} -> {new_row.get('answer')})")
+            problems += 1
+
+        old, new = number(old_row, args.metric), number(new_row, args.metric)
+        change = ""
+        if old is not None and new is not None:
+            if old > 0:
+                ratio = new / old - 1.0
+                change = f"{ratio:+.1%}"
+            if max(old, new) >= args.min_value:
+                if new > old * (1.0 + args.threshold):
+                    status.append("REGRESSION")
+                    problems += 1
+                elif new < old * (1.0 - args.threshold):
+                    status.append("improved")
+        old_text = "" if old is None else f"{old:.6g}"
+        new_text = "" if new is None else f"{new:.6g}"
+        print(f"{day:<5} {phase:<7} {old_text:>14} {new_text:>14} {change:>9}  {', '.join(status) or 'ok'}")
+
+    if problems:
+        print(f"{problems} problem(s) above the {args.threshold:.0%} threshold on {args.metric}.")
+    return 1 if problems else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
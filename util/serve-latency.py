@@ -0,0 +1,98 @@
+# /// script
+# requires-python = ">=3.12"
+# dependencies = []
+# ///
+"""Compare per-request latency of a --serve process against launching the solver each time.
+
+Usage: uv run util/serve-latency.py <executable> <day> <part> <input> [--requests 200]
+
+The executable is a day binary (e.g. build/day-04/day-4) or build/all/aoc-all. The baseline
+runs "<executable> --run-input --only-part<part> --input=<input>" once per request; the server
+is started once with --serve=<socket> and answers the same request over a Unix socket.
+"""
+import argparse
+import os
+import socket
+import statistics
+import subprocess
+import sys
+import tempfile
+import time
+
+
+def summarize(label, samples):
+    samples = sorted(samples)
+    p99 = samples[min(len(samples) - 1, round(0.99 * (len(samples) - 1)))]
+    median = statistics.median(samples)
+    print(f"{label:<12} median {median * 1e3:9.3f} ms   p99 {p99 * 1e3:9.3f} ms   "
+          f"min {samples[0] * 1e3:9.3f} ms")
+    return median
+
+
+def fork_exec(args, requests):
+    command = [args.executable, "--run-input", f"--only-part{args.part}", f"--input={args.input}",
+               "--no-color"]
+    if args.executable.endswith("aoc-all"):
+        command = [args.executable, f"--days={args.day}", f"--only-part{args.part}",
+                   f"--input-dir={os.path.dirname(os.path.dirname(args.input))}"]
+    samples = []
+    for _ in range(requests):
+        start = time.perf_counter()
+        subprocess.run(command, check=True, stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
+        samples.append(time.perf_counter() - start)
+    return samples
+
+
+def served(args, requests):
+    with tempfile.TemporaryDirectory() as directory:
+        path = os.path.join(directory, "aoc.sock")
+        server = subprocess.Popen([args.executable, f"--serve={path}"], stderr=subprocess.DEVNULL)
+        try:
+            for _ in range(500):
+                if os.path.exists(path):
+                    break
+                time.sleep(0.01)
+            client = socket.socket(socket.AF_UNIX, socket.SOCK_STREAM)
+            client.connect(path)
+            reader = client.makefile("r")
+            request = f"{args.day} {args.part} file {os.path.abspath(args.input)}\n".encode()
+            samples = []
+            answer = None
+            for _ in range(requests):
+                start = time.perf_counter()
+                client.sendall(request)
+                response = reader.readline().split()
+                samples.append(time.perf_counter() - start)
+                if response[0] != "ok":
+                    sys.exit(f"server error: {' '.join(response)}")
+                answer = response[1]
+            client.sendall(b"shutdown\n")
+            reader.readline()
+            client.close()
+            server.wait(timeout=10)
+            return samples, answer
+        finally:
+            if server.poll() is None:
+                server.kill()
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("executable")
+    parser.add_argument("day")
+    parser.add_argument("part", choices=("1", "2"))
+    parser.add_argument("input")
+    parser.add_argument("--requests", type=int, default=200)
+    args = parser.parse_args()
+
+    server_samples, answer = served(args, args.requests)
+    exec_samples = fork_exec(args, args.requests)
+    print(f"day {args.day} part {args.part}: answer {answer}, {args.requests} requests each")
+    exec_median = summarize("fork/exec", exec_samples)
+    served_median = summarize("server", server_samples)
+    print(f"speedup      {exec_median / served_median:.1f}x on the median")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())